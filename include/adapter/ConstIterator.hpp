@@ -1,6 +1,7 @@
 /// @file ConstIterator.hpp
 /// @brief Const迭代器适配器
 #pragma once
+#include "../utility/Debug.hpp"
 #include <iostream>
 namespace XuSTL
 {
@@ -43,6 +44,7 @@ namespace XuSTL
         /// @return 常量引用
         Ref operator*() const
         {
+            XUSTL_DEBUG_CHECK(_it != Iterator(), "解引用空迭代器！");
             return *_it;
         }
         /// @brief operator-> 实现
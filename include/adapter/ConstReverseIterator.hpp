@@ -49,7 +49,9 @@ namespace XuSTL
         Ref operator*() const
         {
             Iterator tmp = _it; // 使用临时变量
-            return *(--tmp);    // 返回前一个元素的常量引用
+            --tmp;
+            XUSTL_DEBUG_CHECK(tmp != Iterator(), "解引用空迭代器！");
+            return *tmp; // 返回前一个元素的常量引用
         }
         /// @brief operator-> 实现
         Ptr operator->() const
@@ -2,6 +2,7 @@
 /// @brief 反向迭代器适配器
 #include <iostream>
 #pragma once
+#include "../utility/Debug.hpp"
 
 namespace XuSTL
 {
@@ -47,7 +48,9 @@ namespace XuSTL
         Ref operator*() const
         {
             Iterator tmp = _it; // 使用临时变量
-            return *(--tmp);    // 返回前一个元素的引用
+            --tmp;
+            XUSTL_DEBUG_CHECK(tmp != Iterator(), "解引用空迭代器！");
+            return *tmp; // 返回前一个元素的引用
         }
         /// @brief operator-> 实现
         Ptr operator->()
@@ -0,0 +1,321 @@
+/// @file Parallel.hpp
+/// @brief Vector 的并行算法：for_each transform reduce inclusive_scan sort
+/// @details 连续区间按缓存大小切块，工作线程通过原子计数器动态领取块；
+///          调用时通过执行策略选择串行或并行。
+#pragma once
+#include "../container/Vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+namespace XuSTL
+{
+    /// @brief 一个块能容纳的元素个数，使块的大小与 L2 缓存相当
+    /// @tparam T 元素类型
+    template <class T>
+    size_t CacheGrain()
+    {
+        long bytes = 0;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        if (bytes <= 0)
+            bytes = 256 * 1024;
+        size_t grain = static_cast<size_t>(bytes) / sizeof(T);
+        return grain == 0 ? 1 : grain;
+    }
+
+    namespace execution
+    {
+        /// @brief 串行执行策略
+        struct SequencedPolicy
+        {
+        };
+        /// @brief 并行执行策略
+        struct ParallelPolicy
+        {
+            /// @brief 构造函数
+            /// @param threads 线程数，0 表示使用硬件线程数
+            /// @param grain 每块的元素个数，0 表示按 L2 缓存大小计算
+            constexpr explicit ParallelPolicy(size_t threads = 0, size_t grain = 0) : _threads(threads), _grain(grain) {}
+            /// @brief 实际使用的线程数
+            size_t thread_count() const
+            {
+                if (_threads != 0)
+                    return _threads;
+                size_t hw = std::thread::hardware_concurrency();
+                return hw == 0 ? 1 : hw;
+            }
+            /// @brief 元素类型为 T 时每块的元素个数
+            template <class T>
+            size_t grain() const { return _grain != 0 ? _grain : CacheGrain<T>(); }
+
+        private:
+            size_t _threads; ///< 指定的线程数
+            size_t _grain;   ///< 指定的块大小
+        };
+
+        constexpr SequencedPolicy seq{}; ///< 串行
+        constexpr ParallelPolicy par{};  ///< 并行，使用全部硬件线程
+    }
+
+    /// @brief 把 [0, n) 按 grain 切块并行执行 f(begin, end)，第一个异常会在所有线程结束后重新抛出
+    /// @tparam F 可调用对象，参数为块的起止下标
+    /// @param policy 并行策略
+    /// @param n 区间长度
+    /// @param grain 块大小
+    /// @param f 处理一个块的函数
+    template <class F>
+    void ParallelFor(const execution::ParallelPolicy &policy, size_t n, size_t grain, F f)
+    {
+        size_t chunks = (n + grain - 1) / grain;
+        size_t workers = std::min(policy.thread_count(), chunks);
+        if (workers <= 1)
+        {
+            for (size_t b = 0; b < n; b += grain)
+                f(b, std::min(n, b + grain));
+            return;
+        }
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex mtx;
+        auto work = [&]()
+        {
+            try
+            {
+                for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1))
+                    f(c * grain, std::min(n, (c + 1) * grain));
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error)
+                    error = std::current_exception();
+                next.store(chunks); // 让其他线程尽快停下
+            }
+        };
+        Vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t i = 1; i < workers; i++)
+            threads.emplace_back(work);
+        work();
+        for (auto &t : threads)
+            t.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // for_each
+    /**
+     * @brief 对每个元素调用 f。
+     * @param v Vector。
+     * @param f 参数为元素引用的函数。
+     */
+    template <class T, class Alloc, class Growth, class F>
+    void for_each(const execution::SequencedPolicy &, Vector<T, Alloc, Growth> &v, F f)
+    {
+        for (auto &value : v)
+            f(value);
+    }
+    /**
+     * @brief 并行地对每个元素调用 f，调用顺序不确定。
+     * @param policy 并行策略。
+     * @param v Vector。
+     * @param f 参数为元素引用的函数，需要线程安全。
+     */
+    template <class T, class Alloc, class Growth, class F>
+    void for_each(const execution::ParallelPolicy &policy, Vector<T, Alloc, Growth> &v, F f)
+    {
+        T *p = v.data();
+        ParallelFor(policy, v.size(), policy.template grain<T>(), [&](size_t b, size_t e)
+                    { for (; b < e; b++) f(p[b]); });
+    }
+
+    // transform
+    /**
+     * @brief out[i] = f(in[i])，out 的大小调整为 in 的大小。
+     * @param in 输入。
+     * @param out 输出。
+     * @param f 变换函数。
+     */
+    template <class T, class A1, class G1, class U, class A2, class G2, class F>
+    void transform(const execution::SequencedPolicy &, const Vector<T, A1, G1> &in, Vector<U, A2, G2> &out, F f)
+    {
+        out.resize(in.size());
+        for (size_t i = 0; i < in.size(); i++)
+            out[i] = f(in[i]);
+    }
+    /**
+     * @brief 并行地计算 out[i] = f(in[i])，out 的大小调整为 in 的大小。
+     * @param policy 并行策略。
+     * @param in 输入。
+     * @param out 输出。
+     * @param f 变换函数，需要线程安全。
+     */
+    template <class T, class A1, class G1, class U, class A2, class G2, class F>
+    void transform(const execution::ParallelPolicy &policy, const Vector<T, A1, G1> &in, Vector<U, A2, G2> &out, F f)
+    {
+        out.resize(in.size());
+        const T *src = in.data();
+        U *dst = out.data();
+        ParallelFor(policy, in.size(), policy.template grain<T>(), [&](size_t b, size_t e)
+                    { for (; b < e; b++) dst[b] = f(src[b]); });
+    }
+
+    // reduce
+    /**
+     * @brief 以 init 为初值用 op 归约全部元素。
+     * @param v Vector。
+     * @param init 初值。
+     * @param op 二元运算，默认为加法。
+     * @return 归约结果。
+     */
+    template <class T, class Alloc, class Growth, class Op = std::plus<T>>
+    T reduce(const execution::SequencedPolicy &, const Vector<T, Alloc, Growth> &v, T init, Op op = Op())
+    {
+        for (const T *p = v.data(); p != v.data() + v.size(); ++p)
+            init = op(init, *p);
+        return init;
+    }
+    /**
+     * @brief 并行归约，每块先各自归约，再按块的顺序合并。
+     * @param policy 并行策略。
+     * @param v Vector。
+     * @param init 初值。
+     * @param op 满足结合律的二元运算，默认为加法。
+     * @return 归约结果。
+     */
+    template <class T, class Alloc, class Growth, class Op = std::plus<T>>
+    T reduce(const execution::ParallelPolicy &policy, const Vector<T, Alloc, Growth> &v, T init, Op op = Op())
+    {
+        size_t n = v.size();
+        if (n == 0)
+            return init;
+        size_t grain = policy.template grain<T>();
+        size_t chunks = (n + grain - 1) / grain;
+        Vector<T> partial(chunks, init);
+        const T *p = v.data();
+        ParallelFor(policy, n, grain, [&](size_t b, size_t e)
+                    {
+                        T acc = p[b];
+                        for (size_t i = b + 1; i < e; i++)
+                            acc = op(acc, p[i]);
+                        partial[b / grain] = acc; });
+        for (size_t c = 0; c < chunks; c++)
+            init = op(init, partial[c]);
+        return init;
+    }
+
+    // inclusive_scan
+    /**
+     * @brief 前缀归约：out[i] = in[0] op ... op in[i]，out 可以就是 in。
+     * @param in 输入。
+     * @param out 输出。
+     * @param op 二元运算，默认为加法。
+     */
+    template <class T, class A1, class G1, class A2, class G2, class Op = std::plus<T>>
+    void inclusive_scan(const execution::SequencedPolicy &, const Vector<T, A1, G1> &in, Vector<T, A2, G2> &out, Op op = Op())
+    {
+        out.resize(in.size());
+        for (size_t i = 0; i < in.size(); i++)
+            out[i] = i == 0 ? in[0] : op(out[i - 1], in[i]);
+    }
+    /**
+     * @brief 并行前缀归约，分三步：各块求和、串行求块偏移、各块带偏移扫描。
+     * @param policy 并行策略。
+     * @param in 输入。
+     * @param out 输出，可以就是 in。
+     * @param op 满足结合律的二元运算，默认为加法。
+     */
+    template <class T, class A1, class G1, class A2, class G2, class Op = std::plus<T>>
+    void inclusive_scan(const execution::ParallelPolicy &policy, const Vector<T, A1, G1> &in, Vector<T, A2, G2> &out, Op op = Op())
+    {
+        size_t n = in.size();
+        out.resize(n);
+        if (n == 0)
+            return;
+        size_t grain = policy.template grain<T>();
+        size_t chunks = (n + grain - 1) / grain;
+        const T *src = in.data();
+        T *dst = out.data();
+        Vector<T> offset(chunks, src[0]);
+        ParallelFor(policy, n, grain, [&](size_t b, size_t e)
+                    {
+                        T acc = src[b];
+                        for (size_t i = b + 1; i < e; i++)
+                            acc = op(acc, src[i]);
+                        offset[b / grain] = acc; });
+        // offset[c] 变为前 c 块之和，第 0 块没有偏移
+        for (size_t c = 1; c + 1 < chunks; c++)
+            offset[c] = op(offset[c - 1], offset[c]);
+        ParallelFor(policy, n, grain, [&](size_t b, size_t e)
+                    {
+                        size_t c = b / grain;
+                        T acc = c == 0 ? src[b] : op(offset[c - 1], src[b]);
+                        dst[b] = acc;
+                        for (size_t i = b + 1; i < e; i++)
+                            dst[i] = acc = op(acc, src[i]); });
+    }
+
+    // sort
+    /**
+     * @brief 排序。
+     * @param v Vector。
+     * @param comp 比较函数，默认为小于。
+     */
+    template <class T, class Alloc, class Growth, class Compare = std::less<T>>
+    void sort(const execution::SequencedPolicy &, Vector<T, Alloc, Growth> &v, Compare comp = Compare())
+    {
+        std::sort(v.begin(), v.end(), comp);
+    }
+    /**
+     * @brief 并行排序：切成与线程数相同的段分别排序，再逐轮两两并行归并。
+     * @param policy 并行策略。
+     * @param v Vector。
+     * @param comp 比较函数，默认为小于。
+     */
+    template <class T, class Alloc, class Growth, class Compare = std::less<T>>
+    void sort(const execution::ParallelPolicy &policy, Vector<T, Alloc, Growth> &v, Compare comp = Compare())
+    {
+        size_t n = v.size();
+        const size_t min_run = 2048; // 太短的段不值得开线程
+        size_t runs = std::min(policy.thread_count(), n / min_run);
+        if (runs <= 1)
+        {
+            std::sort(v.begin(), v.end(), comp);
+            return;
+        }
+        Vector<size_t> bound;
+        for (size_t i = 0; i <= runs; i++)
+            bound.push_back(n * i / runs);
+        T *data = v.data();
+        ParallelFor(policy, runs, 1, [&](size_t b, size_t)
+                    { std::sort(data + bound[b], data + bound[b + 1], comp); });
+
+        Vector<T> buf;
+        buf.reserve(n);
+        buf.append(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+        T *src = buf.data(); // 有序段已移入 buf，第一轮从 buf 归并回 data
+        T *dst = data;
+        for (size_t width = 1; width < runs; width *= 2)
+        {
+            size_t pairs = (runs + 2 * width - 1) / (2 * width);
+            ParallelFor(policy, pairs, 1, [&](size_t b, size_t)
+                        {
+                            size_t lo = bound[b * 2 * width];
+                            size_t mid = bound[std::min(runs, b * 2 * width + width)];
+                            size_t hi = bound[std::min(runs, b * 2 * width + 2 * width)];
+                            std::merge(std::make_move_iterator(src + lo), std::make_move_iterator(src + mid),
+                                       std::make_move_iterator(src + mid), std::make_move_iterator(src + hi),
+                                       dst + lo, comp); });
+            std::swap(src, dst);
+        }
+        if (src != data)
+            std::move(src, src + n, data);
+    }
+}
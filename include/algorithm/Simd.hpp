@@ -0,0 +1,508 @@
+/// @file Simd.hpp
+/// @brief 算术类型连续数组的 SIMD 查找、计数、比较与归约
+/// @details 内核使用 GCC 向量扩展编写，分别以 SSE2 / AVX2 / AVX-512 指令集实例化，
+///          运行时根据 CPU 支持情况选择；非 x86 平台、非 GCC 编译器或定义 XUSTL_NO_SIMD 时退化为标量循环。
+#pragma once
+#include "../container/Vector.hpp"
+#include "../utility/Debug.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(XUSTL_NO_SIMD)
+#define XUSTL_SIMD_X86 1
+#else
+#define XUSTL_SIMD_X86 0
+#endif
+
+namespace XuSTL
+{
+    namespace simd
+    {
+        /// @brief 指令集等级
+        enum class SimdLevel
+        {
+            Scalar, ///< 标量循环
+            SSE2,   ///< 128 位
+            AVX2,   ///< 256 位
+            AVX512  ///< 512 位
+        };
+
+        /// @brief 判断类型能否使用 SIMD 内核：1/2/4/8 字节的整数或浮点数（不含 bool）
+        /// @tparam T 数据类型
+        template <class T>
+        struct IsSimdType : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                                             !std::is_same<T, bool>::value &&
+                                                             (sizeof(T) == 1 || sizeof(T) == 2 ||
+                                                              sizeof(T) == 4 || sizeof(T) == 8)>
+        {
+        };
+
+        /// @brief 求和结果类型：有符号整数为 int64_t，无符号整数为 uint64_t，浮点数为 double
+        /// @tparam T 数据类型
+        template <class T, bool = std::is_integral<T>::value, bool = std::is_signed<T>::value>
+        struct SumType
+        {
+            using type = T; ///< 非算术类型直接使用 T 累加
+        };
+        template <class T>
+        struct SumType<T, true, true>
+        {
+            using type = int64_t;
+        };
+        template <class T>
+        struct SumType<T, true, false>
+        {
+            using type = uint64_t;
+        };
+        template <class T, bool Signed>
+        struct SumType<T, false, Signed>
+        {
+            using type = typename std::conditional<std::is_floating_point<T>::value, double, T>::type;
+        };
+
+        /// @brief 检测 CPU 支持的最高指令集
+        inline SimdLevel DetectLevel()
+        {
+#if XUSTL_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+                return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2"))
+                return SimdLevel::AVX2;
+            return SimdLevel::SSE2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+        /// @brief 当前使用的指令集等级，首次调用时检测
+        inline SimdLevel &CurrentLevel()
+        {
+            static SimdLevel level = DetectLevel();
+            return level;
+        }
+        /// @brief 获取当前使用的指令集等级
+        inline SimdLevel level() { return CurrentLevel(); }
+        /// @brief 限制使用的指令集等级，不会超过 CPU 实际支持的等级，主要用于测试
+        /// @param lv 期望的等级
+        inline void force_level(SimdLevel lv)
+        {
+            SimdLevel max = DetectLevel();
+            CurrentLevel() = lv < max ? lv : max;
+        }
+
+        // 标量实现
+        template <class T>
+        size_t FindScalar(const T *p, size_t n, T value)
+        {
+            for (size_t i = 0; i < n; i++)
+                if (p[i] == value)
+                    return i;
+            return n;
+        }
+        template <class T>
+        size_t CountScalar(const T *p, size_t n, T value)
+        {
+            size_t c = 0;
+            for (size_t i = 0; i < n; i++)
+                c += (p[i] == value);
+            return c;
+        }
+        template <class T>
+        bool EqualScalar(const T *a, const T *b, size_t n)
+        {
+            for (size_t i = 0; i < n; i++)
+                if (!(a[i] == b[i]))
+                    return false;
+            return true;
+        }
+        template <class T>
+        T MinScalar(const T *p, size_t n)
+        {
+            T m = p[0];
+            for (size_t i = 1; i < n; i++)
+                if (p[i] < m)
+                    m = p[i];
+            return m;
+        }
+        template <class T>
+        T MaxScalar(const T *p, size_t n)
+        {
+            T m = p[0];
+            for (size_t i = 1; i < n; i++)
+                if (m < p[i])
+                    m = p[i];
+            return m;
+        }
+        template <class T>
+        typename SumType<T>::type SumScalar(const T *p, size_t n)
+        {
+            typename SumType<T>::type s = typename SumType<T>::type();
+            for (size_t i = 0; i < n; i++)
+                s += p[i];
+            return s;
+        }
+
+#if XUSTL_SIMD_X86
+        /// @brief 由元素类型和字节数得到向量类型，借助类模板使 vector_size 在模板中正确生效
+        template <class S, size_t Bytes>
+        struct VecOf
+        {
+            typedef S type __attribute__((vector_size(Bytes)));
+        };
+        /// @brief 与 T 等宽的有符号整数，作为比较结果的掩码元素
+        template <size_t N>
+        struct MaskOf;
+        template <>
+        struct MaskOf<1>
+        {
+            using type = int8_t;
+        };
+        template <>
+        struct MaskOf<2>
+        {
+            using type = int16_t;
+        };
+        template <>
+        struct MaskOf<4>
+        {
+            using type = int32_t;
+        };
+        template <>
+        struct MaskOf<8>
+        {
+            using type = int64_t;
+        };
+
+#define XUSTL_SIMD_INLINE static inline __attribute__((always_inline))
+
+        /// @brief 判断掩码中是否有非零通道
+        template <class M, size_t W>
+        XUSTL_SIMD_INLINE bool AnyKernel(const M &m)
+        {
+            uint64_t words[W / 8];
+            std::memcpy(words, &m, W);
+            uint64_t r = 0;
+            for (size_t i = 0; i < W / 8; i++)
+                r |= words[i];
+            return r != 0;
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE size_t FindKernel(const T *p, size_t n, T value)
+        {
+            typedef typename VecOf<T, W>::type V;
+            typedef typename VecOf<typename MaskOf<sizeof(T)>::type, W>::type M;
+            const size_t L = W / sizeof(T);
+            V key;
+            for (size_t j = 0; j < L; j++)
+                key[j] = value;
+            size_t i = 0;
+            for (; i + L <= n; i += L)
+            {
+                V x;
+                std::memcpy(&x, p + i, W);
+                M m = (M)(x == key);
+                if (AnyKernel<M, W>(m))
+                    for (size_t j = 0; j < L; j++)
+                        if (m[j])
+                            return i + j;
+            }
+            size_t r = FindScalar(p + i, n - i, value);
+            return i + r;
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE size_t CountKernel(const T *p, size_t n, T value)
+        {
+            typedef typename VecOf<T, W>::type V;
+            typedef typename VecOf<typename MaskOf<sizeof(T)>::type, W>::type M;
+            const size_t L = W / sizeof(T);
+            // 每个通道的计数器与 T 等宽，窄类型需要在溢出前汇总
+            const size_t limit = sizeof(T) >= 4 ? SIZE_MAX : (size_t(1) << (8 * sizeof(T) - 1)) - 1;
+            V key;
+            for (size_t j = 0; j < L; j++)
+                key[j] = value;
+            size_t c = 0;
+            size_t i = 0;
+            while (i + L <= n)
+            {
+                M acc = {};
+                for (size_t k = 0; k < limit && i + L <= n; k++, i += L)
+                {
+                    V x;
+                    std::memcpy(&x, p + i, W);
+                    acc -= (M)(x == key);
+                }
+                for (size_t j = 0; j < L; j++)
+                    c += static_cast<size_t>(acc[j]);
+            }
+            return c + CountScalar(p + i, n - i, value);
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE bool EqualKernel(const T *a, const T *b, size_t n)
+        {
+            typedef typename VecOf<T, W>::type V;
+            typedef typename VecOf<typename MaskOf<sizeof(T)>::type, W>::type M;
+            const size_t L = W / sizeof(T);
+            size_t i = 0;
+            for (; i + L <= n; i += L)
+            {
+                V x, y;
+                std::memcpy(&x, a + i, W);
+                std::memcpy(&y, b + i, W);
+                if (AnyKernel<M, W>((M)(x != y)))
+                    return false;
+            }
+            return EqualScalar(a + i, b + i, n - i);
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE T MinKernel(const T *p, size_t n)
+        {
+            typedef typename VecOf<T, W>::type V;
+            const size_t L = W / sizeof(T);
+            if (n < L)
+                return MinScalar(p, n);
+            V acc;
+            std::memcpy(&acc, p, W);
+            size_t i = L;
+            for (; i + L <= n; i += L)
+            {
+                V x;
+                std::memcpy(&x, p + i, W);
+                acc = x < acc ? x : acc;
+            }
+            T m = acc[0];
+            for (size_t j = 1; j < L; j++)
+                if (acc[j] < m)
+                    m = acc[j];
+            if (i < n)
+            {
+                T t = MinScalar(p + i, n - i);
+                if (t < m)
+                    m = t;
+            }
+            return m;
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE T MaxKernel(const T *p, size_t n)
+        {
+            typedef typename VecOf<T, W>::type V;
+            const size_t L = W / sizeof(T);
+            if (n < L)
+                return MaxScalar(p, n);
+            V acc;
+            std::memcpy(&acc, p, W);
+            size_t i = L;
+            for (; i + L <= n; i += L)
+            {
+                V x;
+                std::memcpy(&x, p + i, W);
+                acc = acc < x ? x : acc;
+            }
+            T m = acc[0];
+            for (size_t j = 1; j < L; j++)
+                if (m < acc[j])
+                    m = acc[j];
+            if (i < n)
+            {
+                T t = MaxScalar(p + i, n - i);
+                if (m < t)
+                    m = t;
+            }
+            return m;
+        }
+        template <class T, size_t W>
+        XUSTL_SIMD_INLINE typename SumType<T>::type SumKernel(const T *p, size_t n)
+        {
+            typedef typename SumType<T>::type S;
+            typedef typename VecOf<T, W>::type V;
+            typedef typename VecOf<S, W / sizeof(T) * sizeof(S)>::type VS; // 累加前先拓宽，避免溢出
+            const size_t L = W / sizeof(T);
+            VS acc = {};
+            size_t i = 0;
+            for (; i + L <= n; i += L)
+            {
+                V x;
+                std::memcpy(&x, p + i, W);
+                acc += __builtin_convertvector(x, VS);
+            }
+            S s = SumScalar(p + i, n - i);
+            for (size_t j = 0; j < L; j++)
+                s += acc[j];
+            return s;
+        }
+
+/// @brief 为内核生成 SSE2 / AVX2 / AVX-512 三个实例
+#define XUSTL_SIMD_TARGETS(Ret, Name, Params, Args)                                                      \
+    template <class T>                                                                                   \
+    __attribute__((target("avx512f,avx512bw"))) Ret Name##Avx512 Params { return Name##Kernel<T, 64> Args; } \
+    template <class T>                                                                                   \
+    __attribute__((target("avx2"))) Ret Name##Avx2 Params { return Name##Kernel<T, 32> Args; }             \
+    template <class T>                                                                                   \
+    Ret Name##Sse2 Params { return Name##Kernel<T, 16> Args; }
+
+        XUSTL_SIMD_TARGETS(size_t, Find, (const T *p, size_t n, T value), (p, n, value))
+        XUSTL_SIMD_TARGETS(size_t, Count, (const T *p, size_t n, T value), (p, n, value))
+        XUSTL_SIMD_TARGETS(bool, Equal, (const T *a, const T *b, size_t n), (a, b, n))
+        XUSTL_SIMD_TARGETS(T, Min, (const T *p, size_t n), (p, n))
+        XUSTL_SIMD_TARGETS(T, Max, (const T *p, size_t n), (p, n))
+        XUSTL_SIMD_TARGETS(typename SumType<T>::type, Sum, (const T *p, size_t n), (p, n))
+
+#undef XUSTL_SIMD_TARGETS
+#undef XUSTL_SIMD_INLINE
+
+/// @brief 按当前指令集等级选择实现
+#define XUSTL_SIMD_DISPATCH(Name, ...)              \
+    switch (level())                                \
+    {                                               \
+    case SimdLevel::AVX512:                         \
+        return Name##Avx512<T>(__VA_ARGS__);        \
+    case SimdLevel::AVX2:                           \
+        return Name##Avx2<T>(__VA_ARGS__);          \
+    case SimdLevel::SSE2:                           \
+        return Name##Sse2<T>(__VA_ARGS__);          \
+    default:                                        \
+        return Name##Scalar<T>(__VA_ARGS__);        \
+    }
+#else
+#define XUSTL_SIMD_DISPATCH(Name, ...) return Name##Scalar<T>(__VA_ARGS__);
+#endif
+
+        // 按类型分派：可向量化的类型走 SIMD 内核，其余类型走标量循环
+        template <class T>
+        size_t FindImpl(const T *p, size_t n, T value, std::true_type) { XUSTL_SIMD_DISPATCH(Find, p, n, value) }
+        template <class T>
+        size_t FindImpl(const T *p, size_t n, const T &value, std::false_type) { return FindScalar(p, n, value); }
+        template <class T>
+        size_t CountImpl(const T *p, size_t n, T value, std::true_type) { XUSTL_SIMD_DISPATCH(Count, p, n, value) }
+        template <class T>
+        size_t CountImpl(const T *p, size_t n, const T &value, std::false_type) { return CountScalar(p, n, value); }
+        template <class T>
+        bool EqualImpl(const T *a, const T *b, size_t n, std::true_type) { XUSTL_SIMD_DISPATCH(Equal, a, b, n) }
+        template <class T>
+        bool EqualImpl(const T *a, const T *b, size_t n, std::false_type) { return EqualScalar(a, b, n); }
+        template <class T>
+        T MinImpl(const T *p, size_t n, std::true_type) { XUSTL_SIMD_DISPATCH(Min, p, n) }
+        template <class T>
+        T MinImpl(const T *p, size_t n, std::false_type) { return MinScalar(p, n); }
+        template <class T>
+        T MaxImpl(const T *p, size_t n, std::true_type) { XUSTL_SIMD_DISPATCH(Max, p, n) }
+        template <class T>
+        T MaxImpl(const T *p, size_t n, std::false_type) { return MaxScalar(p, n); }
+        template <class T>
+        typename SumType<T>::type SumImpl(const T *p, size_t n, std::true_type) { XUSTL_SIMD_DISPATCH(Sum, p, n) }
+        template <class T>
+        typename SumType<T>::type SumImpl(const T *p, size_t n, std::false_type) { return SumScalar(p, n); }
+
+#undef XUSTL_SIMD_DISPATCH
+
+        /// @brief 查找第一个等于 value 的元素
+        /// @return 元素下标，找不到时返回 n
+        template <class T>
+        size_t find(const T *p, size_t n, const T &value) { return FindImpl(p, n, value, IsSimdType<T>()); }
+        /// @brief 统计等于 value 的元素个数
+        template <class T>
+        size_t count(const T *p, size_t n, const T &value) { return CountImpl(p, n, value, IsSimdType<T>()); }
+        /// @brief 判断两个长度为 n 的数组是否逐元素相等
+        template <class T>
+        bool equal(const T *a, const T *b, size_t n) { return EqualImpl(a, b, n, IsSimdType<T>()); }
+        /// @brief 最小值，要求 n > 0
+        template <class T>
+        T min(const T *p, size_t n) { return MinImpl(p, n, IsSimdType<T>()); }
+        /// @brief 最大值，要求 n > 0
+        template <class T>
+        T max(const T *p, size_t n) { return MaxImpl(p, n, IsSimdType<T>()); }
+        /// @brief 求和，整数拓宽到 64 位、浮点数拓宽到 double 后累加
+        template <class T>
+        typename SumType<T>::type sum(const T *p, size_t n) { return SumImpl(p, n, IsSimdType<T>()); }
+    }
+
+    /**
+     * @brief 查找第一个等于 value 的元素。
+     * @param v Vector。
+     * @param value 要查找的值。
+     * @return 指向该元素的迭代器，找不到时返回 end()。
+     */
+    template <class T, class Alloc, class Growth>
+    typename Vector<T, Alloc, Growth>::iterator find(Vector<T, Alloc, Growth> &v, const T &value)
+    {
+        return v.data() + simd::find(v.data(), v.size(), value);
+    }
+    /**
+     * @brief 查找第一个等于 value 的元素。
+     * @param v Vector。
+     * @param value 要查找的值。
+     * @return 指向该元素的 const 迭代器，找不到时返回 end()。
+     */
+    template <class T, class Alloc, class Growth>
+    typename Vector<T, Alloc, Growth>::const_iterator find(const Vector<T, Alloc, Growth> &v, const T &value)
+    {
+        using const_iterator = typename Vector<T, Alloc, Growth>::const_iterator;
+        return const_iterator(const_cast<T *>(v.data()) + simd::find(v.data(), v.size(), value));
+    }
+    /**
+     * @brief 统计等于 value 的元素个数。
+     * @param v Vector。
+     * @param value 要统计的值。
+     * @return 元素个数。
+     */
+    template <class T, class Alloc, class Growth>
+    size_t count(const Vector<T, Alloc, Growth> &v, const T &value)
+    {
+        return simd::count(v.data(), v.size(), value);
+    }
+    /**
+     * @brief 判断是否包含 value。
+     * @param v Vector。
+     * @param value 要查找的值。
+     * @return 包含时返回 true。
+     */
+    template <class T, class Alloc, class Growth>
+    bool contains(const Vector<T, Alloc, Growth> &v, const T &value)
+    {
+        return simd::find(v.data(), v.size(), value) != v.size();
+    }
+    /**
+     * @brief 判断两个 Vector 是否大小相同且逐元素相等。
+     * @param a 第一个 Vector。
+     * @param b 第二个 Vector。
+     * @return 相等时返回 true。
+     */
+    template <class T, class A1, class G1, class A2, class G2>
+    bool equal(const Vector<T, A1, G1> &a, const Vector<T, A2, G2> &b)
+    {
+        return a.size() == b.size() && simd::equal(a.data(), b.data(), a.size());
+    }
+    /**
+     * @brief 最小值，定义 XUSTL_DEBUG 时检查是否为空。
+     * @param v 非空 Vector。
+     * @return 最小的元素。
+     */
+    template <class T, class Alloc, class Growth>
+    T min(const Vector<T, Alloc, Growth> &v)
+    {
+        XUSTL_DEBUG_CHECK(!v.empty(), "Vector 为空！");
+        return simd::min(v.data(), v.size());
+    }
+    /**
+     * @brief 最大值，定义 XUSTL_DEBUG 时检查是否为空。
+     * @param v 非空 Vector。
+     * @return 最大的元素。
+     */
+    template <class T, class Alloc, class Growth>
+    T max(const Vector<T, Alloc, Growth> &v)
+    {
+        XUSTL_DEBUG_CHECK(!v.empty(), "Vector 为空！");
+        return simd::max(v.data(), v.size());
+    }
+    /**
+     * @brief 求和，整数拓宽到 64 位、浮点数拓宽到 double 后累加。
+     * @param v Vector。
+     * @return 所有元素之和。
+     */
+    template <class T, class Alloc, class Growth>
+    typename simd::SumType<T>::type sum(const Vector<T, Alloc, Growth> &v)
+    {
+        return simd::sum(v.data(), v.size());
+    }
+}
@@ -0,0 +1,345 @@
+/// @file ThreadPool.hpp
+/// @brief 工作窃取线程池：fork/join 与递归切分的 parallel_for
+/// @details 每个工作线程拥有一个 WorkStealingDeque，新任务压入当前线程队列的底部，
+///          空闲线程从其他线程队列的顶部窃取；适合递归分治（如在 Vector 上建索引）这类任务不均匀的负载。
+#pragma once
+#include "../container/RingBuffer.hpp"
+#include "../container/WorkStealingDeque.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace XuSTL
+{
+    class ThreadPool;
+
+    /// @brief 一组 fork/join 任务，用 ThreadPool::spawn 加入任务，用 ThreadPool::sync 等待全部完成
+    /// @details 某个任务抛出异常后，组内尚未开始的任务不再执行，第一个异常在 sync 中重新抛出。
+    ///          析构前必须已经 sync。
+    class TaskGroup
+    {
+        friend class ThreadPool;
+
+    public:
+        TaskGroup() : _pending(0), _failed(false) {}
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+    private:
+        std::atomic<size_t> _pending; ///< 未完成的任务数
+        std::atomic<bool> _failed;    ///< 是否已有任务抛出异常
+        std::mutex _mutex;            ///< 保护 _error
+        std::exception_ptr _error;    ///< 第一个异常
+    };
+
+    /// @brief 工作窃取线程池
+    /// @details 工作线程先从自己队列的底部取任务（后进先出，刚拆出的子任务数据还在缓存里），
+    ///          再看外部线程提交的任务，最后随机挑选其他线程从顶部窃取（偷走最早拆出、通常最大的任务）。
+    ///          找不到任务时先让出几轮 CPU，仍然没有才在条件变量上休眠；提交任务时只有存在休眠线程才加锁唤醒。
+    ///          sync 不阻塞线程，而是在等待期间帮忙执行任务，因此任务中可以嵌套 spawn 和 sync。
+    class ThreadPool
+    {
+        /// @brief 类型擦除的任务
+        struct Task
+        {
+            TaskGroup *_group; ///< 所属任务组
+
+            explicit Task(TaskGroup *group) : _group(group) {}
+            virtual ~Task() {}
+            virtual void execute() = 0;
+        };
+        /// @brief 包装可调用对象的任务
+        template <class F>
+        struct FuncTask : Task
+        {
+            F _f; ///< 可调用对象
+
+            FuncTask(TaskGroup *group, F &&f) : Task(group), _f(std::move(f)) {}
+            void execute() override { _f(); }
+        };
+        /// @brief 工作线程
+        struct Worker
+        {
+            WorkStealingDeque<Task *> _deque; ///< 本线程的任务队列
+            std::thread _thread;              ///< 线程
+            uint32_t _seed = 0;               ///< 挑选窃取对象的随机数状态
+
+            /// @brief xorshift 随机数
+            uint32_t Random()
+            {
+                _seed ^= _seed << 13;
+                _seed ^= _seed >> 17;
+                _seed ^= _seed << 5;
+                return _seed;
+            }
+        };
+        /// @brief 当前线程所属的线程池和工作线程
+        struct Context
+        {
+            ThreadPool *_pool; ///< 线程池
+            Worker *_worker;   ///< 工作线程
+        };
+
+        static const unsigned SpinRounds = 64; ///< 休眠前找任务的轮数
+
+    public:
+        /**
+         * @brief 构造函数，启动工作线程
+         * @param threads 线程数，0 表示使用硬件线程数
+         */
+        explicit ThreadPool(size_t threads = 0) : _stop(false), _sleepers(0), _injected_count(0)
+        {
+            if (threads == 0)
+                threads = std::thread::hardware_concurrency();
+            _count = threads == 0 ? 1 : threads;
+            _workers.reset(new Worker[_count]);
+            for (size_t i = 0; i < _count; i++)
+                _workers[i]._seed = static_cast<uint32_t>(i * 2654435761u + 1);
+            for (size_t i = 0; i < _count; i++)
+                _workers[i]._thread = std::thread(&ThreadPool::WorkerLoop, this, &_workers[i]);
+        }
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        /**
+         * @brief 析构函数，停止并回收工作线程，丢弃尚未执行的任务
+         */
+        ~ThreadPool()
+        {
+            _stop.store(true, std::memory_order_seq_cst);
+            {
+                std::lock_guard<std::mutex> lock(_park_mutex);
+            }
+            _park_cv.notify_all();
+            for (size_t i = 0; i < _count; i++)
+                _workers[i]._thread.join();
+            Task *t;
+            for (size_t i = 0; i < _count; i++)
+                while (_workers[i]._deque.pop(t))
+                    delete t;
+            while (!_injected.empty())
+            {
+                delete _injected.front();
+                _injected.pop_front();
+            }
+        }
+
+        /// @brief 提交一个任务到任务组：在工作线程中调用时压入本线程的队列，否则放入共享的提交队列
+        /// @tparam F 可调用对象，无参数
+        /// @param group 任务组
+        /// @param f 任务
+        template <class F>
+        void spawn(TaskGroup &group, F f)
+        {
+            Task *t = new FuncTask<F>(&group, std::move(f));
+            group._pending.fetch_add(1, std::memory_order_relaxed);
+            Worker *self = Self();
+            if (self != nullptr)
+                self->_deque.push(t);
+            else
+            {
+                std::lock_guard<std::mutex> lock(_inject_mutex);
+                _injected.push_back(t);
+                _injected_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            Wake();
+        }
+        /// @brief 等待任务组的全部任务完成，等待期间帮忙执行任务
+        /// @param group 任务组
+        /// @throws 组内任务抛出的第一个异常
+        void sync(TaskGroup &group)
+        {
+            Worker *self = Self();
+            Task *t;
+            while (group._pending.load(std::memory_order_acquire) != 0)
+            {
+                if (FindTask(self, t))
+                    Run(t);
+                else
+                    std::this_thread::yield();
+            }
+            if (group._failed.load(std::memory_order_relaxed))
+            {
+                std::exception_ptr error = group._error;
+                group._error = nullptr;
+                group._failed.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(error);
+            }
+        }
+        /// @brief 把 [first, last) 递归二分，直到不超过 grain 后执行 f(begin, end)，全部完成后返回
+        /// @details 每次拆分把后一半作为任务提交、自己继续处理前一半，被窃取的总是最大的那块。
+        /// @tparam F 可调用对象，参数为块的起止下标
+        /// @param first 起始下标
+        /// @param last 结束下标
+        /// @param grain 块大小，0 表示按线程数自动选择
+        /// @param f 处理一个块的函数，需要线程安全
+        /// @throws f 抛出的第一个异常
+        template <class F>
+        void parallel_for(size_t first, size_t last, size_t grain, F f)
+        {
+            if (first >= last)
+                return;
+            if (grain == 0)
+                grain = std::max<size_t>(1, (last - first) / (_count * 8));
+            TaskGroup group;
+            try
+            {
+                SplitFor(group, first, last, grain, f);
+            }
+            catch (...)
+            {
+                sync(group); // 已提交的任务仍引用 f，等它们结束
+                throw;
+            }
+            sync(group);
+        }
+        /**
+         * @brief 获取工作线程数
+         * @return 线程数
+         */
+        size_t thread_count() const { return _count; }
+
+    private:
+        /// @brief 当前线程的上下文
+        static Context &Current()
+        {
+            thread_local Context ctx = {nullptr, nullptr};
+            return ctx;
+        }
+        /// @brief 当前线程若是本线程池的工作线程则返回它，否则返回空
+        Worker *Self() const
+        {
+            Context &ctx = Current();
+            return ctx._pool == this ? ctx._worker : nullptr;
+        }
+        /// @brief 工作线程主循环
+        void WorkerLoop(Worker *self)
+        {
+            Current() = Context{this, self};
+            unsigned idle = 0;
+            Task *t;
+            while (!_stop.load(std::memory_order_acquire))
+            {
+                if (FindTask(self, t))
+                {
+                    Run(t);
+                    idle = 0;
+                }
+                else if (++idle < SpinRounds)
+                    std::this_thread::yield();
+                else
+                {
+                    Park();
+                    idle = 0;
+                }
+            }
+        }
+        /// @brief 依次从自己的队列、提交队列、其他线程的队列找任务
+        /// @param self 当前工作线程，外部线程为空
+        bool FindTask(Worker *self, Task *&out)
+        {
+            if (self != nullptr && self->_deque.pop(out))
+                return true;
+            if (_injected_count.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> lock(_inject_mutex);
+                if (!_injected.empty())
+                {
+                    out = _injected.front();
+                    _injected.pop_front();
+                    _injected_count.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            size_t start = self != nullptr ? self->Random() % _count : 0;
+            for (size_t i = 0; i < _count; i++)
+            {
+                Worker &victim = _workers[(start + i) % _count];
+                if (&victim != self && victim._deque.steal(out))
+                    return true;
+            }
+            return false;
+        }
+        /// @brief 执行任务，记录异常，然后释放任务并递减任务组计数
+        void Run(Task *t)
+        {
+            TaskGroup *group = t->_group;
+            if (!group->_failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    t->execute();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(group->_mutex);
+                    if (!group->_error)
+                        group->_error = std::current_exception();
+                    group->_failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            delete t;
+            group->_pending.fetch_sub(1, std::memory_order_release); // 之后 sync 可能返回并销毁 group
+        }
+        /// @brief 是否还有待执行的任务，近似值
+        bool HasWork() const
+        {
+            if (_injected_count.load(std::memory_order_relaxed) != 0)
+                return true;
+            for (size_t i = 0; i < _count; i++)
+                if (!_workers[i]._deque.empty())
+                    return true;
+            return false;
+        }
+        /// @brief 没有任务时休眠，直到有新任务或线程池析构
+        void Park()
+        {
+            std::unique_lock<std::mutex> lock(_park_mutex);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // 登记休眠先于检查队列，与 Wake 配对
+            if (!_stop.load(std::memory_order_relaxed) && !HasWork())
+                _park_cv.wait(lock);
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+        /// @brief 有线程休眠时唤醒一个
+        void Wake()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst); // 放入任务先于检查休眠数
+            if (_sleepers.load(std::memory_order_relaxed) == 0)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(_park_mutex);
+            }
+            _park_cv.notify_one();
+        }
+        /// @brief parallel_for 的递归拆分
+        template <class F>
+        void SplitFor(TaskGroup &group, size_t b, size_t e, size_t grain, F &f)
+        {
+            while (e - b > grain)
+            {
+                size_t mid = b + (e - b) / 2;
+                spawn(group, [this, &group, mid, e, grain, &f]()
+                      { SplitFor(group, mid, e, grain, f); });
+                e = mid;
+            }
+            f(b, e);
+        }
+
+    private:
+        size_t _count;                       ///< 工作线程数
+        std::unique_ptr<Worker[]> _workers;  ///< 工作线程
+        std::atomic<bool> _stop;             ///< 是否正在析构
+        std::atomic<size_t> _sleepers;       ///< 休眠的线程数
+        std::mutex _park_mutex;              ///< 休眠用的互斥锁
+        std::condition_variable _park_cv;    ///< 休眠用的条件变量
+        std::mutex _inject_mutex;            ///< 保护 _injected
+        std::atomic<size_t> _injected_count; ///< _injected 的元素个数，用于无锁地判断是否为空
+        RingBuffer<Task *> _injected;        ///< 外部线程提交的任务
+    };
+}
@@ -0,0 +1,215 @@
+/// @file AsyncQueue.hpp
+/// @brief 协程可等待的异步队列及单线程执行器
+/// @details 需要 C++20 协程，以更低标准编译时本文件为空。
+#pragma once
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include "Queue.hpp"
+#include "RingBuffer.hpp"
+#include "IntrusiveList.hpp"
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 交给 Executor 运行的协程，不返回结果
+    /// @details 创建后先挂起，由 Executor::spawn 排入就绪队列；运行结束后自行销毁协程帧。
+    class AsyncTask
+    {
+    public:
+        /// @brief 协程的 promise 类型
+        struct promise_type
+        {
+            AsyncTask get_return_object() { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        AsyncTask(AsyncTask &&other) noexcept : _handle(std::exchange(other._handle, nullptr)) {}
+        AsyncTask(const AsyncTask &) = delete;
+        AsyncTask &operator=(const AsyncTask &) = delete;
+        /// @brief 析构函数，从未交给执行器的协程在这里销毁
+        ~AsyncTask()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+        /// @brief 交出协程句柄，之后由接收方负责
+        std::coroutine_handle<> release() { return std::exchange(_handle, nullptr); }
+
+    private:
+        explicit AsyncTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    private:
+        std::coroutine_handle<promise_type> _handle; ///< 协程句柄
+    };
+
+    /// @brief 单线程执行器，按先进先出顺序恢复就绪的协程
+    /// @details 不是线程安全的，spawn schedule run 以及在其上运行的 AsyncQueue 都只能在同一线程使用。
+    class Executor
+    {
+        /// @brief yield 返回的等待体
+        struct YieldAwaiter
+        {
+            Executor *_exec; ///< 执行器
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { _exec->schedule(h); }
+            void await_resume() const noexcept {}
+        };
+
+    public:
+        Executor() = default;
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+        /// @brief 析构函数，销毁仍在就绪队列中的协程
+        ~Executor()
+        {
+            while (!_ready.empty())
+            {
+                _ready.front().destroy();
+                _ready.pop_front();
+            }
+        }
+        /// @brief 把协程排入就绪队列
+        /// @param task 协程
+        void spawn(AsyncTask task) { schedule(task.release()); }
+        /// @brief 把挂起的协程排入就绪队列
+        /// @param h 协程句柄
+        void schedule(std::coroutine_handle<> h) { _ready.push_back(h); }
+        /// @brief 让出执行权，排到就绪队列末尾：co_await exec.yield();
+        YieldAwaiter yield() { return YieldAwaiter{this}; }
+        /// @brief 运行直到没有就绪的协程
+        /// @return 恢复的次数
+        size_t run()
+        {
+            size_t n = 0;
+            while (!_ready.empty())
+            {
+                std::coroutine_handle<> h = _ready.front();
+                _ready.pop_front();
+                h.resume();
+                ++n;
+            }
+            return n;
+        }
+        /**
+         * @brief 是否没有就绪的协程
+         * @return 没有返回 true
+         */
+        bool empty() const { return _ready.empty(); }
+
+    private:
+        RingBuffer<std::coroutine_handle<>> _ready; ///< 就绪队列
+    };
+
+    /// @brief 协程可等待的无界队列
+    /// @details co_await q.pop() 在队列为空时挂起当前协程而不阻塞线程，等待者挂在以协程帧中的钩子串成的
+    ///          IntrusiveList 上，不额外分配内存。push 时若有等待者，元素直接交给最早的等待者，
+    ///          并把它排入执行器的就绪队列，而不是在 push 中就地恢复。
+    ///          与 Executor 一样只能在执行器所在线程使用。
+    /// @tparam T 数据类型
+    /// @tparam Con Queue 的底层容器，默认为 RingBuffer
+    template <class T, class Con = RingBuffer<T>>
+    class AsyncQueue
+    {
+    public:
+        /// @brief pop 返回的等待体
+        class PopAwaiter
+        {
+            friend class AsyncQueue;
+
+        public:
+            explicit PopAwaiter(AsyncQueue *queue) : _queue(queue) {}
+            PopAwaiter(const PopAwaiter &) = delete;
+            PopAwaiter &operator=(const PopAwaiter &) = delete;
+            /// @brief 协程在等待中被销毁时从等待链表中移除
+            ~PopAwaiter()
+            {
+                if (_hook.is_linked())
+                    _queue->_waiters.erase(*this);
+            }
+            bool await_ready() const noexcept { return !_queue->_items.empty(); }
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                _handle = h;
+                _queue->_waiters.push_back(*this);
+            }
+            T await_resume()
+            {
+                if (_value)
+                    return std::move(*_value);
+                T value = std::move(_queue->_items.front());
+                _queue->_items.pop();
+                return value;
+            }
+
+            IntrusiveListHook _hook; ///< 等待链表的钩子
+
+        private:
+            AsyncQueue *_queue;              ///< 所属队列
+            std::coroutine_handle<> _handle; ///< 挂起的协程
+            std::optional<T> _value;         ///< push 直接交来的元素
+        };
+
+        /**
+         * @brief 构造函数
+         * @param exec 恢复等待者所用的执行器，生命周期须长于队列
+         */
+        explicit AsyncQueue(Executor &exec) : _exec(&exec) {}
+        AsyncQueue(const AsyncQueue &) = delete;
+        AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+        /// @brief 入队，有等待者时直接交给最早的等待者并唤醒它
+        /// @param value 数据
+        void push(T value)
+        {
+            if (_waiters.empty())
+            {
+                _items.push(std::move(value));
+                return;
+            }
+            PopAwaiter &w = _waiters.front();
+            _waiters.pop_front();
+            w._value.emplace(std::move(value));
+            _exec->schedule(w._handle);
+        }
+        /// @brief 出队：T value = co_await q.pop(); 队列为空时挂起
+        PopAwaiter pop() { return PopAwaiter(this); }
+        /// @brief 尝试出队，不挂起
+        /// @param out 接收出队元素
+        /// @return 成功返回 true，队列空返回 false
+        bool try_pop(T &out)
+        {
+            if (_items.empty())
+                return false;
+            out = std::move(_items.front());
+            _items.pop();
+            return true;
+        }
+        /**
+         * @brief 获取排队的元素个数
+         * @return 元素个数
+         */
+        size_t size() const { return _items.size(); }
+        /**
+         * @brief 检查是否没有排队的元素
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _items.empty(); }
+        /**
+         * @brief 获取正在等待的协程数
+         * @return 等待者个数
+         */
+        size_t waiters() const { return _waiters.size(); }
+
+    private:
+        Executor *_exec;                                          ///< 执行器
+        Queue<T, Con> _items;                                     ///< 排队的元素
+        IntrusiveList<PopAwaiter, &PopAwaiter::_hook> _waiters; ///< 等待的协程，先到先得
+    };
+}
+#endif
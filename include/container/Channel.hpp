@@ -0,0 +1,262 @@
+/// @file Channel.hpp
+/// @brief 阻塞有界通道
+#pragma once
+#include "Queue.hpp"
+#include "RingBuffer.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 带超时的通道操作的结果
+    enum class ChannelStatus
+    {
+        Ok,      ///< 成功
+        Timeout, ///< 超时
+        Closed   ///< 通道已关闭（push），或已关闭且取空（pop）
+    };
+
+    /// @brief 阻塞有界通道，多生产者多消费者
+    /// @details 元素存放在一个 Queue 中，由一把互斥锁保护。生产者只在满时、消费者只在空时
+    ///          在条件变量上休眠，并且只有确实有对端在休眠时才发出通知。
+    ///          push_bulk/pop_bulk 一次加锁搬运尽可能多的元素，减少每个元素的加锁和唤醒。
+    ///          close 之后 push 全部失败，pop 取完剩余元素后失败，所有休眠的线程被唤醒。
+    /// @tparam T 数据类型
+    /// @tparam Con Queue 的底层容器，默认为 RingBuffer
+    template <class T, class Con = RingBuffer<T>>
+    class Channel
+    {
+        using Clock = std::chrono::steady_clock; ///< 超时使用的时钟
+
+    public:
+        using value_type = T; ///< 数据类型
+
+        /**
+         * @brief 构造函数
+         * @param capacity 容量，至少为 1
+         */
+        explicit Channel(size_t capacity) : _cap(capacity == 0 ? 1 : capacity), _closed(false), _push_waiters(0), _pop_waiters(0) {}
+        Channel(const Channel &) = delete;
+        Channel &operator=(const Channel &) = delete;
+
+        // 发送
+        /// @brief 发送，通道满时等待
+        /// @param value 数据
+        /// @return 成功返回 true，通道已关闭返回 false
+        bool push(const T &value) { return PushOne(value, nullptr) == ChannelStatus::Ok; }
+        /// @brief 发送（移动），通道满时等待
+        /// @param value 数据的右值
+        /// @return 成功返回 true，通道已关闭返回 false
+        bool push(T &&value) { return PushOne(std::move(value), nullptr) == ChannelStatus::Ok; }
+        /// @brief 尝试发送，通道满时立即返回
+        /// @param value 数据
+        /// @return 成功返回 true，通道满或已关闭返回 false
+        bool try_push(const T &value)
+        {
+            Clock::time_point now = Clock::now();
+            return PushOne(value, &now) == ChannelStatus::Ok;
+        }
+        /// @brief 发送，通道满时最多等待 timeout
+        /// @param value 数据
+        /// @param timeout 最长等待时间
+        /// @return 操作结果
+        template <class Rep, class Period>
+        ChannelStatus push_for(const T &value, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+            return PushOne(value, &deadline);
+        }
+        /// @brief 批量发送，通道满时等待，有空位就把能放下的部分一次放入
+        /// @tparam InputIt 输入迭代器类型
+        /// @param first 开始迭代器
+        /// @param last 结束迭代器
+        /// @return 发送的个数，中途关闭时小于区间长度
+        template <class InputIt>
+        size_t push_bulk(InputIt first, InputIt last)
+        {
+            size_t n = 0;
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (first != last)
+            {
+                Wait(lock, _not_full, _push_waiters, nullptr, [this]()
+                     { return _closed || _queue.size() < _cap; });
+                if (_closed)
+                    break;
+                size_t k = 0;
+                for (; first != last && _queue.size() < _cap; ++first, ++k)
+                    _queue.push(*first);
+                n += k;
+                if (_pop_waiters > 0)
+                {
+                    lock.unlock();
+                    Notify(_not_empty, k);
+                    lock.lock();
+                }
+            }
+            return n;
+        }
+
+        // 接收
+        /// @brief 接收，通道空时等待
+        /// @param out 接收元素
+        /// @return 成功返回 true，通道已关闭且取空返回 false
+        bool pop(T &out) { return PopOne(out, nullptr) == ChannelStatus::Ok; }
+        /// @brief 尝试接收，通道空时立即返回
+        /// @param out 接收元素
+        /// @return 成功返回 true，通道空返回 false
+        bool try_pop(T &out)
+        {
+            Clock::time_point now = Clock::now();
+            return PopOne(out, &now) == ChannelStatus::Ok;
+        }
+        /// @brief 接收，通道空时最多等待 timeout
+        /// @param out 接收元素
+        /// @param timeout 最长等待时间
+        /// @return 操作结果
+        template <class Rep, class Period>
+        ChannelStatus pop_for(T &out, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+            return PopOne(out, &deadline);
+        }
+        /// @brief 批量接收，通道空时等待，之后一次取走至多 max 个
+        /// @tparam OutputIt 输出迭代器类型
+        /// @param out 输出位置，元素移动赋值过去
+        /// @param max 最多接收个数
+        /// @return 接收的个数，通道已关闭且取空或 max 为 0 时为 0
+        template <class OutputIt>
+        size_t pop_bulk(OutputIt out, size_t max)
+        {
+            if (max == 0)
+                return 0; // 什么也不取，不必等待
+            std::unique_lock<std::mutex> lock(_mutex);
+            Wait(lock, _not_empty, _pop_waiters, nullptr, [this]()
+                 { return _closed || !_queue.empty(); });
+            size_t k = 0;
+            for (; k < max && !_queue.empty(); ++k, ++out)
+            {
+                *out = std::move(_queue.front());
+                _queue.pop();
+            }
+            bool wake = _push_waiters > 0;
+            lock.unlock();
+            if (wake)
+                Notify(_not_full, k);
+            return k;
+        }
+
+        // 状态
+        /// @brief 关闭通道并唤醒所有等待的线程
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+            }
+            _not_full.notify_all();
+            _not_empty.notify_all();
+        }
+        /**
+         * @brief 是否已关闭
+         * @return 已关闭返回 true
+         */
+        bool closed() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _closed;
+        }
+        /**
+         * @brief 获取元素个数
+         * @return 元素个数
+         */
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _queue.size();
+        }
+        /**
+         * @brief 检查是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return size() == 0; }
+        /**
+         * @brief 获取容量
+         * @return 容量
+         */
+        size_t capacity() const { return _cap; }
+
+    private:
+        /// @brief 在 cv 上等待 ready 成立，deadline 为空时不限时
+        /// @return ready 成立返回 true，超时返回 false
+        template <class Pred>
+        static bool Wait(std::unique_lock<std::mutex> &lock, std::condition_variable &cv, size_t &waiters,
+                         const Clock::time_point *deadline, Pred ready)
+        {
+            if (ready())
+                return true;
+            ++waiters;
+            bool ok = true;
+            if (deadline == nullptr)
+                cv.wait(lock, ready);
+            else
+                ok = cv.wait_until(lock, *deadline, ready);
+            --waiters;
+            return ok;
+        }
+        /// @brief 放入或取走 k 个元素后通知对端，一个元素只需唤醒一个线程
+        static void Notify(std::condition_variable &cv, size_t k)
+        {
+            if (k == 1)
+                cv.notify_one();
+            else if (k > 1)
+                cv.notify_all();
+        }
+        /// @brief 发送一个元素
+        template <class U>
+        ChannelStatus PushOne(U &&value, const Clock::time_point *deadline)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!Wait(lock, _not_full, _push_waiters, deadline, [this]()
+                      { return _closed || _queue.size() < _cap; }))
+                return ChannelStatus::Timeout;
+            if (_closed)
+                return ChannelStatus::Closed;
+            _queue.push(std::forward<U>(value));
+            bool wake = _pop_waiters > 0;
+            lock.unlock();
+            if (wake)
+                _not_empty.notify_one();
+            return ChannelStatus::Ok;
+        }
+        /// @brief 接收一个元素
+        ChannelStatus PopOne(T &out, const Clock::time_point *deadline)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!Wait(lock, _not_empty, _pop_waiters, deadline, [this]()
+                      { return _closed || !_queue.empty(); }))
+                return ChannelStatus::Timeout;
+            if (_queue.empty())
+                return ChannelStatus::Closed;
+            out = std::move(_queue.front());
+            _queue.pop();
+            bool wake = _push_waiters > 0;
+            lock.unlock();
+            if (wake)
+                _not_full.notify_one();
+            return ChannelStatus::Ok;
+        }
+
+    private:
+        Queue<T, Con> _queue;               ///< 元素
+        size_t _cap;                        ///< 容量
+        bool _closed;                       ///< 是否已关闭
+        size_t _push_waiters;               ///< 等待空位的生产者数
+        size_t _pop_waiters;                ///< 等待元素的消费者数
+        mutable std::mutex _mutex;          ///< 保护以上成员
+        std::condition_variable _not_full;  ///< 生产者在此等待
+        std::condition_variable _not_empty; ///< 消费者在此等待
+    };
+}
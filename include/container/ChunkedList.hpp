@@ -0,0 +1,495 @@
+/// @file ChunkedList.hpp
+/// @brief 展开链表：每个节点存放一小段连续元素
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace XuSTL
+{
+    /// @brief 块之间的链接，也是哨兵节点
+    struct ChunkLink
+    {
+        ChunkLink *_prev; ///< 前一块
+        ChunkLink *_next; ///< 后一块
+        size_t _count;    ///< 块中的元素个数，哨兵为 0
+    };
+    /// @brief 数据块
+    /// @tparam T 数据类型
+    /// @tparam ChunkSize 每块的元素个数上限
+    template <class T, size_t ChunkSize>
+    struct Chunk : ChunkLink
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type _data[ChunkSize]; ///< 元素存储
+
+        /// @brief 第 i 个元素的地址
+        T *at(size_t i) { return reinterpret_cast<T *>(&_data[i]); }
+    };
+
+    /// @brief 前向声明
+    /// @tparam T 数据类型
+    /// @tparam ChunkSize 每块的元素个数上限
+    /// @tparam Alloc 分配器
+    template <class T, size_t ChunkSize = 32, class Alloc = std::allocator<T>>
+    class ChunkedList;
+    /// @brief 展开链表迭代器，由所在块和块内下标组成
+    /// @tparam T 数据类型
+    /// @tparam ChunkSize 每块的元素个数上限
+    /// @tparam Ref 数据引用
+    /// @tparam Ptr 数据指针
+    template <class T, size_t ChunkSize, class Ref = T &, class Ptr = T *>
+    class ChunkedListIterator
+    {
+        template <class, size_t, class>
+        friend class ChunkedList; ///< 允许 ChunkedList 访问私有成员
+
+        using Self = ChunkedListIterator<T, ChunkSize, Ref, Ptr>; ///< 自身类型
+        using ChunkType = Chunk<T, ChunkSize>;                    ///< 块类型
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag; ///< 迭代器类别
+        using value_type = T;                                       ///< 数据类型
+        using difference_type = std::ptrdiff_t;                     ///< 距离类型
+        using pointer = Ptr;                                        ///< 数据指针
+        using reference = Ref;                                      ///< 数据引用
+
+        /// @brief 构造函数
+        /// @param chunk 所在块
+        /// @param idx 块内下标
+        ChunkedListIterator(ChunkLink *chunk = nullptr, size_t idx = 0) : _chunk(chunk), _idx(idx) {}
+        /**
+         * @brief 解引用操作符，返回当前元素
+         * @return 当前元素的引用
+         */
+        Ref operator*() const
+        {
+            XUSTL_DEBUG_CHECK(_chunk != nullptr && _idx < _chunk->_count, "解引用无效的展开链表迭代器！");
+            return *static_cast<ChunkType *>(_chunk)->at(_idx);
+        }
+        /**
+         * @brief 箭头操作符，返回当前元素的指针
+         * @return 当前元素的指针
+         */
+        Ptr operator->() const { return &**this; }
+        Self &operator++()
+        {
+            if (++_idx == _chunk->_count)
+            {
+                _chunk = _chunk->_next;
+                _idx = 0;
+            }
+            return *this;
+        }
+        Self operator++(int)
+        {
+            Self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        Self &operator--()
+        {
+            if (_idx == 0)
+            {
+                _chunk = _chunk->_prev;
+                _idx = _chunk->_count;
+            }
+            --_idx;
+            return *this;
+        }
+        Self operator--(int)
+        {
+            Self tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        bool operator==(const Self &other) const { return _chunk == other._chunk && _idx == other._idx; }
+        bool operator!=(const Self &other) const { return !(*this == other); }
+
+    private:
+        ChunkLink *_chunk; ///< 所在块
+        size_t _idx;       ///< 块内下标
+    };
+
+    /// @brief 展开链表
+    /// @details 每块连续存放至多 ChunkSize 个元素，遍历时一块只有一次缓存未命中。
+    ///          在迭代器处插入和删除只移动所在块内的元素，块满时对半分裂，
+    ///          块过空时与后一块合并，均为 O(ChunkSize)。
+    ///          插入和删除会使所在块（分裂、合并时还有相邻块）上的迭代器失效。
+    /// @tparam T 数据类型
+    /// @tparam ChunkSize 每块的元素个数上限
+    /// @tparam Alloc 分配器，会被重绑定到块类型
+    template <class T, size_t ChunkSize, class Alloc>
+    class ChunkedList
+    {
+        static_assert(ChunkSize >= 2, "每块至少容纳 2 个元素");
+        using ChunkType = Chunk<T, ChunkSize>;                                                           ///< 块类型
+        using chunk_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<ChunkType>; ///< 块分配器
+        using chunk_traits = std::allocator_traits<chunk_allocator>;                                     ///< 块分配器萃取
+
+    public:
+        using allocator_type = Alloc;                                                        ///< 分配器类型
+        using iterator = ChunkedListIterator<T, ChunkSize>;                                  ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;                        ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>; ///< const 反向迭代器
+        // 迭代器相关
+        iterator begin() { return iterator(_head._next, 0); }
+        iterator end() { return iterator(&_head, 0); }
+        const_iterator begin() const { return const_iterator(iterator(_head._next, 0)); }
+        const_iterator end() const { return const_iterator(iterator(const_cast<ChunkLink *>(&_head), 0)); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(const_cast<ChunkLink *>(&_head), 0)); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_head._next, 0)); }
+
+        // 构造函数和析构函数
+        ChunkedList() : _size(0) { Init(); }
+        /**
+         * @brief 使用指定分配器构造空链表
+         * @param alloc 分配器
+         */
+        explicit ChunkedList(const Alloc &alloc) : _size(0), _alloc(alloc) { Init(); }
+        /**
+         * @brief 使用迭代器范围构造链表
+         * @tparam T_iterator 迭代器类型
+         * @param first 开始迭代器
+         * @param last 结束迭代器
+         * @param alloc 分配器
+         */
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        ChunkedList(T_iterator first, T_iterator last, const Alloc &alloc = Alloc()) : _size(0), _alloc(alloc)
+        {
+            Init();
+            try
+            {
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+        }
+        /**
+         * @brief 初始化列表构造函数
+         * @param list 初始化列表
+         * @param alloc 分配器
+         */
+        ChunkedList(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : ChunkedList(list.begin(), list.end(), alloc) {}
+        /**
+         * @brief 拷贝构造函数，按块整段拷贝
+         * @param other 另一个链表
+         */
+        ChunkedList(const ChunkedList &other)
+            : _size(0), _alloc(chunk_traits::select_on_container_copy_construction(other._alloc))
+        {
+            Init();
+            try
+            {
+                for (const ChunkLink *c = other._head._next; c != &other._head; c = c->_next)
+                {
+                    ChunkType *src = static_cast<ChunkType *>(const_cast<ChunkLink *>(c));
+                    ChunkType *dst = NewChunk(_head._prev);
+                    for (; dst->_count < src->_count; ++dst->_count)
+                        ::new (static_cast<void *>(dst->at(dst->_count))) T(*src->at(dst->_count));
+                    _size += dst->_count;
+                }
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+        }
+        /**
+         * @brief 移动构造函数，接管另一个链表的全部块，O(1)
+         * @param other 另一个链表，之后为空
+         */
+        ChunkedList(ChunkedList &&other) noexcept : _size(0), _alloc(std::move(other._alloc))
+        {
+            Init();
+            TakeFrom(other);
+        }
+        /**
+         * @brief 析构函数
+         */
+        ~ChunkedList() { clear(); }
+
+        // 重载
+        ChunkedList &operator=(const ChunkedList &other)
+        {
+            if (this != &other)
+            {
+                ChunkedList tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+        ChunkedList &operator=(ChunkedList &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                std::swap(_alloc, other._alloc);
+                TakeFrom(other);
+            }
+            return *this;
+        }
+        bool operator==(const ChunkedList &other) const
+        {
+            if (_size != other._size)
+                return false;
+            for (auto it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2)
+                if (!(*it1 == *it2))
+                    return false;
+            return true;
+        }
+        bool operator!=(const ChunkedList &other) const { return !(*this == other); }
+
+        // 容量相关
+        /**
+         * @brief 获取链表的大小
+         * @return 元素个数
+         */
+        size_t size() const { return _size; }
+        /**
+         * @brief 检查链表是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _size == 0; }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return Alloc(_alloc); }
+        /**
+         * @brief 清空链表，归还全部块
+         */
+        void clear()
+        {
+            for (ChunkLink *c = _head._next; c != &_head;)
+            {
+                ChunkLink *next = c->_next;
+                ChunkType *chunk = static_cast<ChunkType *>(c);
+                for (size_t i = 0; i < chunk->_count; i++)
+                    chunk->at(i)->~T();
+                FreeChunk(chunk);
+                c = next;
+            }
+            Init();
+            _size = 0;
+        }
+
+        // 获取数据
+        /**
+         * @brief 获取第一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 第一个元素的引用
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *static_cast<ChunkType *>(_head._next)->at(0);
+        }
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *static_cast<ChunkType *>(_head._next)->at(0);
+        }
+        /**
+         * @brief 获取最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 最后一个元素的引用
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *static_cast<ChunkType *>(_head._prev)->at(_head._prev->_count - 1);
+        }
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *static_cast<ChunkType *>(_head._prev)->at(_head._prev->_count - 1);
+        }
+
+        // 修改
+        /// @brief 尾插，最后一块已满时在末尾新建一块
+        /// @param value 数据
+        void push_back(const T &value) { insert(end(), value); }
+        /// @brief 尾删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(iterator(_head._prev, _head._prev->_count - 1));
+        }
+        /// @brief 头插
+        /// @param value 数据
+        void push_front(const T &value) { insert(begin(), value); }
+        /// @brief 头删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(begin());
+        }
+        /// @brief 在 pos 之前插入，所在块已满时先对半分裂
+        /// @param pos 插入位置
+        /// @param value 数据
+        /// @return 指向新元素的迭代器
+        iterator insert(iterator pos, const T &value)
+        {
+            ChunkLink *c = pos._chunk;
+            size_t i = pos._idx;
+            if (c == &_head || i == 0)
+            {
+                // 插在块首时优先追加到前一块的末尾，不用移动元素
+                ChunkLink *prev = c->_prev;
+                if (prev != &_head && prev->_count < ChunkSize)
+                    c = prev, i = prev->_count;
+                else if (c == &_head)
+                    c = NewChunk(prev), i = 0;
+            }
+            ChunkType *chunk = static_cast<ChunkType *>(c);
+            if (chunk->_count == ChunkSize)
+            {
+                T tmp(value); // value 可能就在要移动的块中
+                size_t half = ChunkSize / 2;
+                ChunkType *right = Split(chunk, half);
+                if (i > half)
+                    chunk = right, i -= half;
+                InsertInChunk(chunk, i, std::move(tmp));
+            }
+            else
+                InsertInChunk(chunk, i, value);
+            ++_size;
+            return iterator(chunk, i);
+        }
+        /// @brief 删除 pos 处的元素，块变空时归还，块过空时并入后一块
+        /// @param pos 指定位置
+        /// @return 原来下一个元素的迭代器
+        iterator erase(iterator pos)
+        {
+            XUSTL_DEBUG_CHECK(pos._chunk != &_head && pos._idx < pos._chunk->_count, "删除无效的位置！");
+            ChunkType *chunk = static_cast<ChunkType *>(pos._chunk);
+            size_t i = pos._idx;
+            std::move(chunk->at(i + 1), chunk->at(chunk->_count), chunk->at(i));
+            chunk->at(--chunk->_count)->~T();
+            --_size;
+            if (chunk->_count == 0)
+            {
+                ChunkLink *next = chunk->_next;
+                Unlink(chunk);
+                FreeChunk(chunk);
+                return iterator(next, 0);
+            }
+            ChunkLink *next = chunk->_next;
+            if (next != &_head && chunk->_count + next->_count <= ChunkSize / 2)
+                MergeNext(chunk);
+            if (i < chunk->_count)
+                return iterator(chunk, i);
+            return iterator(chunk->_next, 0);
+        }
+        /// @brief 交换两个链表
+        /// @param other 另一个链表
+        void swap(ChunkedList &other) noexcept
+        {
+            ChunkedList tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        /// @brief 把哨兵置为空链表
+        void Init()
+        {
+            _head._prev = _head._next = &_head;
+            _head._count = 0;
+        }
+        /// @brief 接管 other 的全部块，调用前自己须为空
+        void TakeFrom(ChunkedList &other) noexcept
+        {
+            if (other._size == 0)
+                return;
+            _head._next = other._head._next;
+            _head._prev = other._head._prev;
+            _head._next->_prev = &_head;
+            _head._prev->_next = &_head;
+            _size = other._size;
+            other.Init();
+            other._size = 0;
+        }
+        /// @brief 在 prev 之后新建一个空块
+        ChunkType *NewChunk(ChunkLink *prev)
+        {
+            ChunkType *chunk = chunk_traits::allocate(_alloc, 1);
+            chunk->_count = 0;
+            chunk->_prev = prev;
+            chunk->_next = prev->_next;
+            prev->_next->_prev = chunk;
+            prev->_next = chunk;
+            return chunk;
+        }
+        /// @brief 归还块，块中元素须已析构
+        void FreeChunk(ChunkType *chunk) { chunk_traits::deallocate(_alloc, chunk, 1); }
+        /// @brief 把块从链中摘下
+        static void Unlink(ChunkLink *chunk)
+        {
+            chunk->_prev->_next = chunk->_next;
+            chunk->_next->_prev = chunk->_prev;
+        }
+        /// @brief 在未满的块中下标 i 处插入元素
+        template <class V>
+        static void InsertInChunk(ChunkType *chunk, size_t i, V &&value)
+        {
+            size_t n = chunk->_count;
+            if (i == n)
+                ::new (static_cast<void *>(chunk->at(n))) T(std::forward<V>(value));
+            else
+            {
+                T tmp(std::forward<V>(value));
+                ::new (static_cast<void *>(chunk->at(n))) T(std::move(*chunk->at(n - 1)));
+                std::move_backward(chunk->at(i), chunk->at(n - 1), chunk->at(n));
+                *chunk->at(i) = std::move(tmp);
+            }
+            ++chunk->_count;
+        }
+        /// @brief 把块中 [keep, count) 的元素移到其后新建的块
+        /// @return 新块
+        ChunkType *Split(ChunkType *chunk, size_t keep)
+        {
+            ChunkType *right = NewChunk(chunk);
+            for (size_t j = keep; j < chunk->_count; j++)
+            {
+                ::new (static_cast<void *>(right->at(right->_count))) T(std::move(*chunk->at(j)));
+                ++right->_count;
+                chunk->at(j)->~T();
+            }
+            chunk->_count = keep;
+            return right;
+        }
+        /// @brief 把后一块的元素全部移入当前块并归还后一块
+        void MergeNext(ChunkType *chunk)
+        {
+            ChunkType *next = static_cast<ChunkType *>(chunk->_next);
+            for (size_t j = 0; j < next->_count; j++)
+            {
+                ::new (static_cast<void *>(chunk->at(chunk->_count))) T(std::move(*next->at(j)));
+                ++chunk->_count;
+                next->at(j)->~T();
+            }
+            Unlink(next);
+            FreeChunk(next);
+        }
+
+    private:
+        ChunkLink _head;        ///< 哨兵，_next 为第一块，_prev 为最后一块
+        size_t _size;           ///< 元素个数
+        chunk_allocator _alloc; ///< 块分配器
+    };
+}
@@ -0,0 +1,111 @@
+/// @file ConcurrentStack.hpp
+/// @brief 无锁栈
+#pragma once
+#include "../memory/Epoch.hpp"
+#include <atomic>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 无锁栈（Treiber 栈），多线程可同时 push 和 pop
+    /// @details 栈顶是一个原子指针，push 和 pop 都只对它做 CAS。
+    ///          pop 摘下的节点交给 EpochDomain 推迟释放：其他线程可能刚读到该节点、正要读它的 next，
+    ///          在它们退出临界区之前节点不会被释放，地址也不会被新节点复用，所以 CAS 不会遇到 ABA 问题。
+    /// @tparam T 数据类型
+    template <class T>
+    class ConcurrentStack
+    {
+        /// @brief 节点，发布后 _next 不再修改
+        struct Node
+        {
+            T _data;     ///< 数据
+            Node *_next; ///< 下一个节点
+
+            template <class... Args>
+            Node(Args &&...args) : _data(std::forward<Args>(args)...), _next(nullptr) {}
+        };
+
+    public:
+        using value_type = T; ///< 数据类型
+
+        ConcurrentStack() : _head(nullptr) {}
+        ConcurrentStack(const ConcurrentStack &) = delete;
+        ConcurrentStack &operator=(const ConcurrentStack &) = delete;
+        /**
+         * @brief 析构函数，此时不能再有线程访问栈
+         */
+        ~ConcurrentStack() { DeleteChain(_head.load(std::memory_order_relaxed)); }
+
+        /// @brief 入栈
+        /// @param value 数据
+        void push(const T &value) { emplace(value); }
+        /// @brief 入栈（移动）
+        /// @param value 数据的右值
+        void push(T &&value) { emplace(std::move(value)); }
+        /// @brief 在栈顶原地构造
+        /// @param args 构造参数
+        template <class... Args>
+        void emplace(Args &&...args)
+        {
+            Node *node = new Node(std::forward<Args>(args)...);
+            node->_next = _head.load(std::memory_order_relaxed);
+            while (!_head.compare_exchange_weak(node->_next, node, std::memory_order_release, std::memory_order_relaxed))
+                ;
+        }
+        /// @brief 尝试出栈
+        /// @param out 接收栈顶元素
+        /// @return 成功返回 true，栈空返回 false
+        bool try_pop(T &out)
+        {
+            EpochGuard guard;
+            Node *node = _head.load(std::memory_order_acquire);
+            while (node != nullptr && !_head.compare_exchange_weak(node, node->_next, std::memory_order_acquire, std::memory_order_acquire))
+                ;
+            if (node == nullptr)
+                return false;
+            out = std::move(node->_data);
+            EpochDomain::instance().retire(node, &DeleteNode);
+            return true;
+        }
+        /// @brief 一次取走全部元素，按出栈顺序（后进先出）输出
+        /// @tparam OutputIt 输出迭代器类型
+        /// @param out 输出位置，元素移动赋值过去
+        /// @return 取走的个数
+        template <class OutputIt>
+        size_t pop_all(OutputIt out)
+        {
+            EpochGuard guard;
+            Node *chain = _head.exchange(nullptr, std::memory_order_acquire);
+            if (chain == nullptr)
+                return 0;
+            size_t n = 0;
+            for (Node *node = chain; node != nullptr; node = node->_next, ++out, ++n)
+                *out = std::move(node->_data);
+            EpochDomain::instance().retire(chain, &DeleteChain); // 整条链只登记一次
+            return n;
+        }
+        /**
+         * @brief 检查是否为空，并发时只是近似值
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _head.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        /// @brief 释放一个节点
+        static void DeleteNode(void *p) { delete static_cast<Node *>(p); }
+        /// @brief 释放从 p 开始的整条链
+        static void DeleteChain(void *p)
+        {
+            Node *node = static_cast<Node *>(p);
+            while (node != nullptr)
+            {
+                Node *next = node->_next;
+                delete node;
+                node = next;
+            }
+        }
+
+    private:
+        std::atomic<Node *> _head; ///< 栈顶
+    };
+}
@@ -1,106 +1,496 @@
-// /// @file Deque.hpp
-// /// @brief 双向队列
-// #pragma once
-// #include "../adapter/ReverseIterator.hpp"
-// #include "../adapter/ConstIterator.hpp"
-// #include "../adapter/ConstReverseIterator.hpp"
-// #include "Vector.hpp"
-// #include <iostream>
-// #include <initializer_list>
-
-// namespace XuSTL
-// {
-
-//     template <class T, size_t BLOCK_SIZE = 64>
-//     class Deque;
-
-//     template <class T, class Ref = T &, class Ptr = T *, size_t BLOCK_SIZE = 64>
-//     class DequeIterator
-//     {
-//     private:
-//         using Self = ListIterator<T, Ref, Ptr>; ///< 自身类型
-//     public:
-//         DequeIterator(T **blocks, size_t block_count,
-//                       size_t block_index, size_t element_index) : _blocks(blocks), _block_count(block_count),
-//                                                                   _block_index(block_index), _element_index(element_index) {}
-//         DequeIterator(const Self &other) : _blocks(other._blocks), _block_count(other._block_count),
-//                                            _block_index(other._block_index), _element_index(other._element_index) {}
-
-//         DequeIterator(Self &&other) : _blocks(std::move(other._blocks)), _block_count(other._block_count),
-//                                       _block_index(other._block_index), _element_index(other._element_index) { other._blocks = nullptr; }
-
-//         Self &operator=(const Self &other)
-//         {
-//             if (this != &other)
-//             {
-//                 _blocks = other._blocks;
-//                 _block_count = other._block_count;
-//                 _block_index = other._block_index;
-//                 _element_index = other._element_index;
-//             }
-//             return *this;
-//         }
-//         Self &operator=(Self &&other) noexcept
-//         {
-//             if (this != &other)
-//             {
-//                 _blocks = std::move(other._blocks);
-//                 _block_count = other._block_count;
-//                 _block_index = other._block_index;
-//                 _element_index = other._element_index;
-//                 other._blocks = nullptr;
-//             }
-//             return *this;
-//         }
-//         Ref operator*() const;
-//         Ptr operator->();
-//         Self &operator++();
-//         Self operator++(int);
-//         Self &operator--();
-//         Self operator--(int);
-//         bool operator==(const Self &other) const;
-//         bool operator!=(const Self &other) const;
-
-//     private:
-//         T **_blocks;           ///< 指针数组
-//         size_t _block_count;   ///< 内存块数量
-//         size_t _block_index;   ///< 当前内存块下标
-//         size_t _element_index; ///< 当前块中的元素下标
-//     };
-
-//     template <class T, size_t BLOCK_SIZE = 64>
-//     class Deque
-//     {
-//     private:
-//         using Ref = T &;
-//         using Ptr = T *;
-
-//     public:
-//         using iterator = DequeIterator<T, Ref, Ptr, BLOCK_SIZE>;       ///< 普通迭代器
-//         using const_iterator = ConstIterator<iterator>;                ///< const 迭代器
-//         using reverse_iterator = ReverseIterator<iterator>;            ///< 反向迭代器
-//         using const_reverse_iterator = ConstReverseIterator<iterator>; ///< const 反向迭代器
-
-//         Deque();
-//         ~Deque();
-//         size_t size();
-//         bool empty();
-//         void push_front();
-//         void push_back();
-//         void pop_front();
-//         void pop_back();
-//         T &operator[](size_t index);
-//         const T &operator[](size_t index);
-
-//     private:
-//         void resize(int new_block_count);
-//         void ensure_capacity();
-
-//     private:
-//         T **_blocks;
-//         size_t _block_count;
-//         size_t _size;
-//         size_t _front;
-//         size_t _back;
-//     };
-// }
\ No newline at end of file
+/// @file Deque.hpp
+/// @brief 双向队列
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 前向声明
+    /// @tparam T 数据类型
+    /// @tparam BLOCK_SIZE 每块的元素个数
+    /// @tparam Alloc 分配器
+    template <class T, size_t BLOCK_SIZE = 64, class Alloc = std::allocator<T>>
+    class Deque;
+
+    /// @brief 双向队列迭代器，由块指针数组和绝对位置组成
+    /// @details 绝对位置 pos 对应第 pos / BLOCK_SIZE 块中的第 pos % BLOCK_SIZE 个元素，
+    ///          移动迭代器只需加减 pos，随机访问为 O(1)。
+    /// @tparam T 数据类型
+    /// @tparam Ref 数据引用
+    /// @tparam Ptr 数据指针
+    /// @tparam BLOCK_SIZE 每块的元素个数
+    template <class T, class Ref = T &, class Ptr = T *, size_t BLOCK_SIZE = 64>
+    class DequeIterator
+    {
+        template <class, size_t, class>
+        friend class Deque; ///< 允许 Deque 访问私有成员
+
+        using Self = DequeIterator<T, Ref, Ptr, BLOCK_SIZE>; ///< 自身类型
+
+    public:
+        using iterator_category = std::random_access_iterator_tag; ///< 迭代器类别
+        using value_type = T;                                       ///< 数据类型
+        using difference_type = std::ptrdiff_t;                     ///< 距离类型
+        using pointer = Ptr;                                        ///< 数据指针
+        using reference = Ref;                                      ///< 数据引用
+
+        /// @brief 构造函数
+        /// @param blocks 块指针数组
+        /// @param pos 绝对位置
+        DequeIterator(T **blocks = nullptr, size_t pos = 0) : _blocks(blocks), _pos(pos) {}
+        /**
+         * @brief 解引用操作符，返回当前元素
+         * @return 当前元素的引用
+         */
+        Ref operator*() const
+        {
+            XUSTL_DEBUG_CHECK(_blocks != nullptr, "解引用无效的双向队列迭代器！");
+            return _blocks[_pos / BLOCK_SIZE][_pos % BLOCK_SIZE];
+        }
+        /**
+         * @brief 箭头操作符，返回当前元素的指针
+         * @return 当前元素的指针
+         */
+        Ptr operator->() const { return &**this; }
+        Ref operator[](difference_type n) const { return *(*this + n); }
+        Self &operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+        Self operator++(int)
+        {
+            Self tmp = *this;
+            ++_pos;
+            return tmp;
+        }
+        Self &operator--()
+        {
+            --_pos;
+            return *this;
+        }
+        Self operator--(int)
+        {
+            Self tmp = *this;
+            --_pos;
+            return tmp;
+        }
+        Self &operator+=(difference_type n)
+        {
+            _pos += n;
+            return *this;
+        }
+        Self &operator-=(difference_type n)
+        {
+            _pos -= n;
+            return *this;
+        }
+        Self operator+(difference_type n) const { return Self(_blocks, _pos + n); }
+        Self operator-(difference_type n) const { return Self(_blocks, _pos - n); }
+        difference_type operator-(const Self &other) const { return static_cast<difference_type>(_pos - other._pos); }
+        bool operator==(const Self &other) const { return _blocks == other._blocks && _pos == other._pos; }
+        bool operator!=(const Self &other) const { return !(*this == other); }
+        bool operator<(const Self &other) const { return _pos < other._pos; }
+        bool operator>(const Self &other) const { return other < *this; }
+        bool operator<=(const Self &other) const { return !(other < *this); }
+        bool operator>=(const Self &other) const { return !(*this < other); }
+
+    private:
+        T **_blocks; ///< 块指针数组
+        size_t _pos; ///< 绝对位置
+    };
+
+    /// @brief 双向队列，可作为 Stack 和 Queue 的底层容器
+    /// @details 元素存放在定长的块中，块指针数组（map）记录各块。元素占据绝对位置 [_start, _start + _size)，
+    ///          头尾增删只在两端的块中进行，需要新块时才申请，块清空时归还（缓存一块备用，避免在块边界来回申请）。
+    ///          map 两端用尽时，若占用不到一半则把块指针挪回中间，否则扩大一倍，已用的块仍放在中间。
+    ///          两端插入不会移动已有元素，引用和指针保持有效；map 变化时迭代器失效。
+    /// @tparam T 数据类型
+    /// @tparam BLOCK_SIZE 每块的元素个数
+    /// @tparam Alloc 分配器
+    template <class T, size_t BLOCK_SIZE, class Alloc>
+    class Deque
+    {
+        static_assert(BLOCK_SIZE > 0, "BLOCK_SIZE 必须大于 0");
+        using alloc_traits = std::allocator_traits<Alloc>;                                     ///< 元素分配器萃取
+        using map_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<T *>; ///< map 分配器
+        using map_traits = std::allocator_traits<map_allocator>;                                 ///< map 分配器萃取
+
+        static const size_t MinMapSize = 8; ///< 第一次分配的 map 大小
+
+    public:
+        using allocator_type = Alloc;                                                        ///< 分配器类型
+        using iterator = DequeIterator<T, T &, T *, BLOCK_SIZE>;                             ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;                        ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>; ///< const 反向迭代器
+        // 迭代器相关
+        iterator begin() { return iterator(_blocks, _start); }
+        iterator end() { return iterator(_blocks, _start + _size); }
+        const_iterator begin() const { return const_iterator(iterator(_blocks, _start)); }
+        const_iterator end() const { return const_iterator(iterator(_blocks, _start + _size)); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(_blocks, _start + _size)); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_blocks, _start)); }
+
+        // 构造函数和析构函数
+        Deque() : _blocks(nullptr), _block_count(0), _size(0), _start(0), _spare(nullptr) {}
+        /**
+         * @brief 使用指定分配器构造空队列
+         * @param alloc 分配器
+         */
+        explicit Deque(const Alloc &alloc) : _blocks(nullptr), _block_count(0), _size(0), _start(0), _spare(nullptr), _alloc(alloc), _map_alloc(alloc) {}
+        /**
+         * @brief 使用迭代器范围构造
+         * @tparam T_iterator 迭代器类型
+         * @param first 开始迭代器
+         * @param last 结束迭代器
+         * @param alloc 分配器
+         */
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        Deque(T_iterator first, T_iterator last, const Alloc &alloc = Alloc()) : Deque(alloc)
+        {
+            for (; first != last; ++first) // 委托构造已完成，异常时析构函数会清理
+                push_back(*first);
+        }
+        /**
+         * @brief 初始化列表构造函数
+         * @param list 初始化列表
+         * @param alloc 分配器
+         */
+        Deque(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : Deque(list.begin(), list.end(), alloc) {}
+        /**
+         * @brief 拷贝构造函数
+         * @param other 另一个队列
+         */
+        Deque(const Deque &other) : Deque(alloc_traits::select_on_container_copy_construction(other._alloc))
+        {
+            for (size_t i = 0; i < other._size; i++)
+                push_back(other[i]);
+        }
+        /**
+         * @brief 移动构造函数
+         * @param other 另一个队列，之后为空
+         */
+        Deque(Deque &&other) noexcept : Deque(other._alloc) { swap(other); }
+        /**
+         * @brief 析构函数
+         */
+        ~Deque()
+        {
+            clear();
+            if (_spare != nullptr)
+                alloc_traits::deallocate(_alloc, _spare, BLOCK_SIZE);
+            if (_blocks != nullptr)
+                map_traits::deallocate(_map_alloc, _blocks, _block_count);
+        }
+
+        // 重载
+        Deque &operator=(const Deque &other)
+        {
+            if (this != &other)
+            {
+                Deque tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+        Deque &operator=(Deque &&other) noexcept
+        {
+            Deque tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+        bool operator==(const Deque &other) const
+        {
+            if (_size != other._size)
+                return false;
+            for (size_t i = 0; i < _size; i++)
+                if (!((*this)[i] == other[i]))
+                    return false;
+            return true;
+        }
+        bool operator!=(const Deque &other) const { return !(*this == other); }
+        /**
+         * @brief 返回指定位置的元素，O(1)；定义 XUSTL_DEBUG 时检查越界
+         * @param index 元素位置
+         * @return 指定位置的元素
+         */
+        T &operator[](size_t index)
+        {
+            XUSTL_DEBUG_CHECK(index < _size, "越界访问！");
+            return *At(_start + index);
+        }
+        const T &operator[](size_t index) const
+        {
+            XUSTL_DEBUG_CHECK(index < _size, "越界访问！");
+            return *At(_start + index);
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界
+         * @param index 元素位置
+         * @return 指定位置的元素
+         * @throws std::out_of_range 如果 index 越界
+         */
+        T &at(size_t index)
+        {
+            if (index >= _size)
+                throw std::out_of_range("越界访问！");
+            return (*this)[index];
+        }
+        const T &at(size_t index) const
+        {
+            if (index >= _size)
+                throw std::out_of_range("越界访问！");
+            return (*this)[index];
+        }
+
+        // 容量相关
+        /**
+         * @brief 获取元素个数
+         * @return 元素个数
+         */
+        size_t size() const { return _size; }
+        /**
+         * @brief 检查是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _size == 0; }
+        /**
+         * @brief 清空元素，归还全部块，保留 map
+         */
+        void clear()
+        {
+            while (_size > 0)
+                pop_back();
+        }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return _alloc; }
+
+        // 获取数据
+        /**
+         * @brief 获取第一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 第一个元素的引用
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            return *At(_start);
+        }
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            return *At(_start);
+        }
+        /**
+         * @brief 获取最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 最后一个元素的引用
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            return *At(_start + _size - 1);
+        }
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            return *At(_start + _size - 1);
+        }
+
+        // 修改
+        /// @brief 尾插
+        /// @param value 数据
+        void push_back(const T &value) { emplace_back(value); }
+        /// @brief 尾插（移动）
+        /// @param value 数据的右值
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        /// @brief 在尾部原地构造，均摊 O(1)
+        /// @param args 构造参数
+        /// @return 新元素的引用
+        template <class... Args>
+        T &emplace_back(Args &&...args)
+        {
+            if (_blocks == nullptr || (_size > 0 && (_start + _size) % BLOCK_SIZE == 0 && (_start + _size) / BLOCK_SIZE == _block_count))
+                ReserveMap(false);
+            size_t pos = _start + _size;
+            bool fresh = _size == 0 || pos % BLOCK_SIZE == 0;
+            if (fresh)
+                _blocks[pos / BLOCK_SIZE] = AllocateBlock();
+            try
+            {
+                alloc_traits::construct(_alloc, At(pos), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                if (fresh)
+                    FreeBlock(pos / BLOCK_SIZE);
+                throw;
+            }
+            ++_size;
+            return *At(pos);
+        }
+        /// @brief 头插
+        /// @param value 数据
+        void push_front(const T &value) { emplace_front(value); }
+        /// @brief 头插（移动）
+        /// @param value 数据的右值
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+        /// @brief 在头部原地构造，均摊 O(1)
+        /// @param args 构造参数
+        /// @return 新元素的引用
+        template <class... Args>
+        T &emplace_front(Args &&...args)
+        {
+            if (_blocks == nullptr || _start == 0)
+                ReserveMap(true);
+            size_t pos = _start - 1;
+            bool fresh = _size == 0 || _start % BLOCK_SIZE == 0;
+            if (fresh)
+                _blocks[pos / BLOCK_SIZE] = AllocateBlock();
+            try
+            {
+                alloc_traits::construct(_alloc, At(pos), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                if (fresh)
+                    FreeBlock(pos / BLOCK_SIZE);
+                throw;
+            }
+            _start = pos;
+            ++_size;
+            return *At(pos);
+        }
+        /// @brief 尾删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            size_t pos = _start + _size - 1;
+            alloc_traits::destroy(_alloc, At(pos));
+            --_size;
+            if (_size == 0 || pos % BLOCK_SIZE == 0)
+                FreeBlock(pos / BLOCK_SIZE);
+            if (_size == 0)
+                Recenter();
+        }
+        /// @brief 头删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "双向队列为空！");
+            size_t pos = _start;
+            alloc_traits::destroy(_alloc, At(pos));
+            ++_start;
+            --_size;
+            if (_size == 0 || _start % BLOCK_SIZE == 0)
+                FreeBlock(pos / BLOCK_SIZE);
+            if (_size == 0)
+                Recenter();
+        }
+        /// @brief 交换两个队列
+        /// @param other 另一个队列
+        void swap(Deque &other) noexcept
+        {
+            std::swap(_blocks, other._blocks);
+            std::swap(_block_count, other._block_count);
+            std::swap(_size, other._size);
+            std::swap(_start, other._start);
+            std::swap(_spare, other._spare);
+            std::swap(_alloc, other._alloc);
+            std::swap(_map_alloc, other._map_alloc);
+        }
+
+    private:
+        /// @brief 绝对位置对应的元素地址
+        T *At(size_t pos) const { return _blocks[pos / BLOCK_SIZE] + pos % BLOCK_SIZE; }
+        /// @brief 申请一块，优先使用备用块
+        T *AllocateBlock()
+        {
+            T *block = _spare;
+            if (block == nullptr)
+                return alloc_traits::allocate(_alloc, BLOCK_SIZE);
+            _spare = nullptr;
+            return block;
+        }
+        /// @brief 归还第 idx 块，没有备用块时留作备用
+        void FreeBlock(size_t idx)
+        {
+            if (_spare == nullptr)
+                _spare = _blocks[idx];
+            else
+                alloc_traits::deallocate(_alloc, _blocks[idx], BLOCK_SIZE);
+            _blocks[idx] = nullptr;
+        }
+        /// @brief 队列为空时把起点放回 map 中间
+        void Recenter() { _start = _block_count / 2 * BLOCK_SIZE; }
+        /// @brief 保证 map 在指定一端还有空位
+        /// @param at_front 为 true 时在头部留出空位，否则在尾部
+        void ReserveMap(bool at_front)
+        {
+            if (_blocks == nullptr)
+            {
+                _blocks = map_traits::allocate(_map_alloc, MinMapSize);
+                _block_count = MinMapSize;
+                std::fill(_blocks, _blocks + _block_count, nullptr);
+                Recenter();
+                return;
+            }
+            if (_size == 0)
+            {
+                Recenter();
+                return;
+            }
+            size_t first = _start / BLOCK_SIZE;
+            size_t used = (_start + _size - 1) / BLOCK_SIZE - first + 1;
+            size_t count = _block_count;
+            T **blocks = _blocks;
+            if (_block_count < 2 * (used + 1)) // 占用过半，扩大一倍
+            {
+                count = _block_count * 2;
+                blocks = map_traits::allocate(_map_alloc, count);
+                std::fill(blocks, blocks + count, nullptr);
+            }
+            size_t new_first = (count - used) / 2 + (at_front ? 1 : 0);
+            std::memmove(blocks + new_first, _blocks + first, used * sizeof(T *));
+            if (blocks != _blocks)
+            {
+                map_traits::deallocate(_map_alloc, _blocks, _block_count);
+                _blocks = blocks;
+                _block_count = count;
+            }
+            else
+            {
+                // 原地挪动后，清空挪出的旧位置
+                for (size_t i = first; i < first + used; i++)
+                    if (i < new_first || i >= new_first + used)
+                        _blocks[i] = nullptr;
+            }
+            _start = new_first * BLOCK_SIZE + _start % BLOCK_SIZE;
+        }
+
+    private:
+        T **_blocks;              ///< 块指针数组（map），未使用的位置为空
+        size_t _block_count;      ///< map 的大小
+        size_t _size;             ///< 元素个数
+        size_t _start;            ///< 第一个元素的绝对位置
+        T *_spare;                ///< 备用的空块
+        Alloc _alloc;             ///< 元素分配器
+        map_allocator _map_alloc; ///< map 分配器
+    };
+}
@@ -1,8 +1,11 @@
 /// @file HashTable.hpp
 /// @brief 开散列哈希桶
 #pragma once
+#include "Vector.hpp"
+#include "../memory/NodePool.hpp"
+#include "../utility/Serialize.hpp"
 #include <iostream>
-#include <vector>
+#include <memory>
 
 namespace XuSTL
 {
@@ -14,33 +17,48 @@ namespace XuSTL
         HashNode(const T &val = T()) : _next(nullptr), _data(val) {}
     };
 
-    template <class Key, class Val, class KeyOfVal, class Hash>
+    template <class Key, class Val, class KeyOfVal, class Hash, class Alloc = std::allocator<Val>>
     class HashTable
     {
         using Node = HashNode<Val>;
         using pNode = Node *;
+        using bucket_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<pNode>;
 
     public:
-        HashTable() { _tables.resize(10, nullptr); }
-        ~HashTable()
+        using allocator_type = Alloc;
+        /// @brief 构造函数，桶数组和节点都通过 alloc 申请
+        /// @param alloc 分配器
+        explicit HashTable(const Alloc &alloc = Alloc()) : _tables(bucket_allocator(alloc)), _pool(alloc) { _tables.resize(10, nullptr); }
+        ~HashTable() { Clear(); }
+        /// @brief 元素个数
+        size_t Size() const { return _n; }
+        /// @brief 删除全部元素，析构后整块归还节点内存
+        void Clear()
         {
-            for (auto node : _tables)
+            for (auto &head : _tables)
             {
-                while (node != nullptr)
-                {
-                    pNode tmp = node;
-                    node = node->_next;
-                    delete tmp;
-                }
+                DestroyChain(head, std::is_trivially_destructible<Val>());
+                head = nullptr;
             }
             _n = 0;
+            _pool.release();
         }
         bool Insert(const Val &data)
         {
             Key key = KeyOfVal()(data);
             size_t index = Hash()(key) % _tables.size();
 
-            pNode newNode = new Node(data);
+            void *p = _pool.allocate();
+            pNode newNode;
+            try
+            {
+                newNode = new (p) Node(data);
+            }
+            catch (...)
+            {
+                _pool.deallocate(p);
+                throw;
+            }
             newNode->_next = _tables[index];
             _tables[index] = newNode;
             _n++;
@@ -71,7 +89,8 @@ namespace XuSTL
                         prev->_next = node->_next;
                     else 
                         _tables[index] = node->_next;
-                    delete node;
+                    node->~Node();
+                    _pool.deallocate(node);
                     _n--;
                     return true;
                 }
@@ -81,8 +100,99 @@ namespace XuSTL
             return false;
         }
 
+        /// @brief 以二进制格式写入输出流，元素按桶的顺序写出
+        /// @param os 输出流
+        /// @throws std::runtime_error 写入失败时抛出
+        void Serialize(std::ostream &os) const
+        {
+            StreamWriter w(os);
+            SerializeTo(w);
+        }
+        /// @brief 以二进制格式写入文件描述符，平凡可拷贝的元素按节点收集后用 writev 写出
+        /// @param fd 文件描述符
+        /// @throws std::system_error 写入失败时抛出
+        void Serialize(int fd) const
+        {
+            FdWriter w(fd);
+            SerializeTo(w);
+        }
+        /// @brief 从输入流读取 Serialize 写出的数据，替换当前内容
+        /// @param is 输入流
+        /// @throws std::runtime_error 数据不完整或格式不匹配时抛出
+        void Deserialize(std::istream &is)
+        {
+            StreamReader r(is);
+            DeserializeFrom(r);
+        }
+        /// @brief 从文件描述符读取 Serialize 写出的数据，替换当前内容
+        /// @param fd 文件描述符
+        /// @throws std::runtime_error 数据不完整或格式不匹配时抛出
+        /// @throws std::system_error 读取失败时抛出
+        void Deserialize(int fd)
+        {
+            FdReader r(fd);
+            DeserializeFrom(r);
+        }
+
+    private:
+        /// @brief 写出文件头和全部元素
+        template <class Writer>
+        void SerializeTo(Writer &w) const
+        {
+            const bool bulk = std::is_trivially_copyable<Val>::value;
+            WriteSerialHeader(w, SerialKind::HashTable, bulk, sizeof(Val), _n);
+            struct iovec iov[IOV_MAX];
+            size_t cnt = 0;
+            for (pNode head : _tables)
+            {
+                for (pNode node = head; node != nullptr; node = node->_next)
+                {
+                    if (!bulk)
+                    {
+                        Serializer<Val>::write(w, node->_data);
+                        continue;
+                    }
+                    iov[cnt].iov_base = &node->_data;
+                    iov[cnt].iov_len = sizeof(Val);
+                    if (++cnt == IOV_MAX)
+                    {
+                        w.write_gather(iov, cnt);
+                        cnt = 0;
+                    }
+                }
+            }
+            w.write_gather(iov, cnt);
+            w.flush();
+        }
+        /// @brief 读取文件头并逐个插入元素
+        template <class Reader>
+        void DeserializeFrom(Reader &r)
+        {
+            SerialHeader h = ReadSerialHeader(r, SerialKind::HashTable, sizeof(Val), std::is_trivially_copyable<Val>::value);
+            Clear();
+            for (size_t i = 0; i < h.count; i++)
+            {
+                Val value;
+                Serializer<Val>::read(r, value);
+                Insert(value);
+            }
+        }
+
+        /// @brief 析构一条链上的节点，元素可平凡析构时无需遍历
+        void DestroyChain(pNode, std::true_type) {}
+        void DestroyChain(pNode node, std::false_type)
+        {
+            while (node != nullptr)
+            {
+                pNode tmp = node;
+                node = node->_next;
+                tmp->~Node();
+            }
+        }
+
     private:
-        std::vector<pNode> _tables;
+        Vector<pNode, bucket_allocator> _tables;
         size_t _n = 0;
+        NodePool<Node, Alloc> _pool;
     };
 }
\ No newline at end of file
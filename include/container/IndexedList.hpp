@@ -0,0 +1,558 @@
+/// @file IndexedList.hpp
+/// @brief 支持 O(log n) 按下标访问、插入和删除的链表
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/NodePool.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace XuSTL
+{
+    /// @brief 节点的链接部分，也是哨兵
+    /// @details _prev/_next 与 List 一样按顺序串起全部节点，用于遍历；
+    ///          _left/_right/_parent 组成以子树大小为附加信息的树堆（treap），用于按下标定位。
+    struct IndexedLink
+    {
+        IndexedLink *_prev;   ///< 顺序上的前一个节点
+        IndexedLink *_next;   ///< 顺序上的后一个节点
+        IndexedLink *_left;   ///< 左子树
+        IndexedLink *_right;  ///< 右子树
+        IndexedLink *_parent; ///< 父节点
+        size_t _size;         ///< 子树节点数
+        uint32_t _prio;       ///< 堆优先级，父节点不小于子节点
+    };
+    /// @brief 节点结构
+    /// @tparam T 数据类型
+    template <class T>
+    struct IndexedNode : IndexedLink
+    {
+        T _data; ///< 数据
+
+        /// @brief 构造函数
+        /// @param val 数据
+        IndexedNode(const T &val) : _data(val) {}
+    };
+
+    template <class T, class Alloc>
+    class IndexedList;
+    /// @brief 按顺序遍历的迭代器
+    /// @tparam T 数据类型
+    /// @tparam Ref 数据引用
+    /// @tparam Ptr 数据指针
+    template <class T, class Ref = T &, class Ptr = T *>
+    class IndexedListIterator
+    {
+        template <class, class>
+        friend class IndexedList;                         ///< 允许 IndexedList 访问私有成员
+        using Self = IndexedListIterator<T, Ref, Ptr>; ///< 自身类型
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag; ///< 迭代器类别
+        using value_type = T;                                       ///< 数据类型
+        using difference_type = std::ptrdiff_t;                     ///< 距离类型
+        using pointer = Ptr;                                        ///< 数据指针
+        using reference = Ref;                                      ///< 数据引用
+
+        /// @brief 构造函数
+        /// @param link 当前节点
+        IndexedListIterator(IndexedLink *link = nullptr) : _link(link) {}
+        /**
+         * @brief 解引用操作符，返回当前元素
+         * @return 当前元素的引用
+         */
+        Ref operator*() const
+        {
+            XUSTL_DEBUG_CHECK(_link != nullptr, "解引用无效的迭代器！");
+            return static_cast<IndexedNode<T> *>(_link)->_data;
+        }
+        /**
+         * @brief 箭头操作符，返回当前元素的指针
+         * @return 当前元素的指针
+         */
+        Ptr operator->() const { return &**this; }
+        Self &operator++()
+        {
+            _link = _link->_next;
+            return *this;
+        }
+        Self operator++(int)
+        {
+            Self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        Self &operator--()
+        {
+            _link = _link->_prev;
+            return *this;
+        }
+        Self operator--(int)
+        {
+            Self tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        bool operator==(const Self &other) const { return _link == other._link; }
+        bool operator!=(const Self &other) const { return _link != other._link; }
+
+    private:
+        IndexedLink *_link; ///< 当前节点
+    };
+
+    /// @brief 带下标的链表
+    /// @details 节点之间既按顺序双向链接，又组成按子树大小定位的树堆，
+    ///          operator[] insert_at erase_at 以及在迭代器处插入删除均为期望 O(log n)，遍历为 O(1) 一步。
+    ///          节点从 NodePool 分配。插入删除不会使其他元素的迭代器失效。
+    /// @tparam T 数据类型
+    /// @tparam Alloc 分配器
+    template <class T, class Alloc = std::allocator<T>>
+    class IndexedList
+    {
+        using Node = IndexedNode<T>; ///< 节点类型
+        using Link = IndexedLink;    ///< 链接类型
+
+    public:
+        using allocator_type = Alloc;                                                        ///< 分配器类型
+        using iterator = IndexedListIterator<T>;                                             ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;                        ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>; ///< const 反向迭代器
+        // 迭代器相关
+        iterator begin() { return iterator(_head._next); }
+        iterator end() { return iterator(&_head); }
+        const_iterator begin() const { return const_iterator(iterator(_head._next)); }
+        const_iterator end() const { return const_iterator(iterator(const_cast<Link *>(&_head))); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(const_cast<Link *>(&_head))); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_head._next)); }
+
+        // 构造函数和析构函数
+        IndexedList() : _root(nullptr), _seed(0x9E3779B9u) { Init(); }
+        /**
+         * @brief 使用指定分配器构造空链表
+         * @param alloc 分配器
+         */
+        explicit IndexedList(const Alloc &alloc) : _root(nullptr), _seed(0x9E3779B9u), _pool(alloc) { Init(); }
+        /**
+         * @brief 使用迭代器范围构造链表
+         * @tparam T_iterator 迭代器类型
+         * @param first 开始迭代器
+         * @param last 结束迭代器
+         * @param alloc 分配器
+         */
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        IndexedList(T_iterator first, T_iterator last, const Alloc &alloc = Alloc())
+            : _root(nullptr), _seed(0x9E3779B9u), _pool(alloc)
+        {
+            Init();
+            try
+            {
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+            catch (...)
+            {
+                clear();
+                throw;
+            }
+        }
+        /**
+         * @brief 初始化列表构造函数
+         * @param list 初始化列表
+         * @param alloc 分配器
+         */
+        IndexedList(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : IndexedList(list.begin(), list.end(), alloc) {}
+        /**
+         * @brief 拷贝构造函数
+         * @param other 另一个链表
+         */
+        IndexedList(const IndexedList &other)
+            : IndexedList(other.begin(), other.end(),
+                          std::allocator_traits<Alloc>::select_on_container_copy_construction(other.get_allocator())) {}
+        /**
+         * @brief 移动构造函数，接管另一个链表的全部节点，O(1)
+         * @param other 另一个链表，之后为空
+         */
+        IndexedList(IndexedList &&other) noexcept : _root(nullptr), _seed(other._seed), _pool(std::move(other._pool))
+        {
+            Init();
+            TakeFrom(other);
+        }
+        /**
+         * @brief 析构函数
+         */
+        ~IndexedList() { clear(); }
+
+        // 重载
+        IndexedList &operator=(const IndexedList &other)
+        {
+            if (this != &other)
+            {
+                IndexedList tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+        IndexedList &operator=(IndexedList &&other) noexcept
+        {
+            IndexedList tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+        bool operator==(const IndexedList &other) const
+        {
+            if (size() != other.size())
+                return false;
+            for (auto it1 = begin(), it2 = other.begin(); it1 != end(); ++it1, ++it2)
+                if (!(*it1 == *it2))
+                    return false;
+            return true;
+        }
+        bool operator!=(const IndexedList &other) const { return !(*this == other); }
+        /**
+         * @brief 返回指定位置的元素，O(log n)；定义 XUSTL_DEBUG 时检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         */
+        T &operator[](size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return static_cast<Node *>(NodeAt(pos))->_data;
+        }
+        const T &operator[](size_t pos) const
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return static_cast<Node *>(NodeAt(pos))->_data;
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         * @throws std::out_of_range 如果 pos 越界
+         */
+        T &at(size_t pos)
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return (*this)[pos];
+        }
+        const T &at(size_t pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return (*this)[pos];
+        }
+
+        // 容量相关
+        /**
+         * @brief 获取链表的大小
+         * @return 元素个数
+         */
+        size_t size() const { return Size(_root); }
+        /**
+         * @brief 检查链表是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _root == nullptr; }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return _pool.get_allocator(); }
+        /**
+         * @brief 清空链表，析构全部元素后整块归还节点内存
+         */
+        void clear()
+        {
+            for (Link *l = _head._next; l != &_head;)
+            {
+                Link *next = l->_next;
+                static_cast<Node *>(l)->~Node();
+                l = next;
+            }
+            Init();
+            _root = nullptr;
+            _pool.release();
+        }
+
+        // 获取数据
+        /**
+         * @brief 获取第一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 第一个元素的引用
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return static_cast<Node *>(_head._next)->_data;
+        }
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return static_cast<Node *>(_head._next)->_data;
+        }
+        /**
+         * @brief 获取最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 最后一个元素的引用
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return static_cast<Node *>(_head._prev)->_data;
+        }
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return static_cast<Node *>(_head._prev)->_data;
+        }
+        /**
+         * @brief 迭代器所指元素的下标，O(log n)
+         * @param pos 迭代器，end() 返回 size()
+         * @return 下标
+         */
+        size_t index_of(iterator pos) const
+        {
+            Link *l = pos._link;
+            if (l == &_head)
+                return size();
+            size_t idx = Size(l->_left);
+            for (; l->_parent != nullptr; l = l->_parent)
+                if (l == l->_parent->_right)
+                    idx += Size(l->_parent->_left) + 1;
+            return idx;
+        }
+
+        // 修改
+        /// @brief 尾插
+        /// @param value 数据
+        void push_back(const T &value) { insert(end(), value); }
+        /// @brief 头插
+        /// @param value 数据
+        void push_front(const T &value) { insert(begin(), value); }
+        /// @brief 尾删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(iterator(_head._prev));
+        }
+        /// @brief 头删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(begin());
+        }
+        /// @brief 在下标 pos 处插入，之后的元素下标加一，定义 XUSTL_DEBUG 时检查越界
+        /// @param pos 下标，可以等于 size()
+        /// @param value 数据
+        /// @return 指向新元素的迭代器
+        iterator insert_at(size_t pos, const T &value)
+        {
+            XUSTL_DEBUG_CHECK(pos <= size(), "越界访问！");
+            return insert(iterator(pos == size() ? &_head : NodeAt(pos)), value);
+        }
+        /// @brief 删除下标 pos 处的元素，定义 XUSTL_DEBUG 时检查越界
+        /// @param pos 下标
+        /// @return 原来下一个元素的迭代器
+        iterator erase_at(size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return erase(iterator(NodeAt(pos)));
+        }
+        /// @brief 在 pos 之前插入
+        /// @param pos 插入位置
+        /// @param value 数据
+        /// @return 指向新元素的迭代器
+        iterator insert(iterator pos, const T &value)
+        {
+            Link *node = NewNode(value);
+            Link *next = pos._link;
+            // 顺序链表：接在 next 之前
+            node->_prev = next->_prev;
+            node->_next = next;
+            next->_prev->_next = node;
+            next->_prev = node;
+            // 树：成为 next 的前驱，next 为哨兵时成为最右节点
+            Link *parent = nullptr;
+            Link **slot = &_root;
+            if (next != &_head && next->_left == nullptr)
+                parent = next, slot = &next->_left;
+            else if (_root != nullptr)
+            {
+                parent = next != &_head ? next->_left : _root;
+                while (parent->_right != nullptr)
+                    parent = parent->_right;
+                slot = &parent->_right;
+            }
+            *slot = node;
+            node->_parent = parent;
+            for (Link *p = parent; p != nullptr; p = p->_parent)
+                ++p->_size;
+            while (node->_parent != nullptr && node->_prio > node->_parent->_prio)
+            {
+                if (node == node->_parent->_left)
+                    RotateRight(node->_parent);
+                else
+                    RotateLeft(node->_parent);
+            }
+            return iterator(node);
+        }
+        /// @brief 删除 pos 处的元素
+        /// @param pos 指定位置
+        /// @return 原来下一个元素的迭代器
+        iterator erase(iterator pos)
+        {
+            Link *node = pos._link;
+            XUSTL_DEBUG_CHECK(node != nullptr && node != &_head, "删除无效的位置！");
+            Link *next = node->_next;
+            node->_prev->_next = next;
+            next->_prev = node->_prev;
+            // 旋转到至多只有一个子树，再用子树顶替
+            while (node->_left != nullptr && node->_right != nullptr)
+            {
+                if (node->_left->_prio > node->_right->_prio)
+                    RotateRight(node);
+                else
+                    RotateLeft(node);
+            }
+            Link *child = node->_left != nullptr ? node->_left : node->_right;
+            Replace(node, child);
+            for (Link *p = node->_parent; p != nullptr; p = p->_parent)
+                --p->_size;
+            FreeNode(static_cast<Node *>(node));
+            return iterator(next);
+        }
+        /// @brief 交换两个链表
+        /// @param other 另一个链表
+        void swap(IndexedList &other) noexcept
+        {
+            IndexedList tmp(std::move(other));
+            other.TakeFrom(*this);
+            other._pool.swap(_pool);
+            TakeFrom(tmp);
+            _pool.swap(tmp._pool);
+            std::swap(_seed, other._seed);
+        }
+
+    private:
+        /// @brief 子树大小
+        static size_t Size(const Link *l) { return l != nullptr ? l->_size : 0; }
+        /// @brief 把哨兵置为空链表
+        void Init()
+        {
+            _head._prev = _head._next = &_head;
+            _head._left = _head._right = _head._parent = nullptr;
+            _head._size = 0;
+        }
+        /// @brief 接管 other 的全部节点，不含节点池，调用前自己须为空
+        void TakeFrom(IndexedList &other) noexcept
+        {
+            _root = other._root;
+            if (_root == nullptr)
+                return;
+            _head._next = other._head._next;
+            _head._prev = other._head._prev;
+            _head._next->_prev = &_head;
+            _head._prev->_next = &_head;
+            other.Init();
+            other._root = nullptr;
+        }
+        /// @brief 下标为 pos 的节点
+        Link *NodeAt(size_t pos) const
+        {
+            Link *l = _root;
+            for (;;)
+            {
+                size_t left = Size(l->_left);
+                if (pos < left)
+                    l = l->_left;
+                else if (pos == left)
+                    return l;
+                else
+                    pos -= left + 1, l = l->_right;
+            }
+        }
+        /// @brief 用 child 顶替 node 在树中的位置
+        void Replace(Link *node, Link *child)
+        {
+            Link *parent = node->_parent;
+            if (parent == nullptr)
+                _root = child;
+            else if (parent->_left == node)
+                parent->_left = child;
+            else
+                parent->_right = child;
+            if (child != nullptr)
+                child->_parent = parent;
+        }
+        /// @brief 左旋，x 的右子节点成为 x 的父节点
+        void RotateLeft(Link *x)
+        {
+            Link *y = x->_right;
+            x->_right = y->_left;
+            if (y->_left != nullptr)
+                y->_left->_parent = x;
+            Replace(x, y);
+            y->_left = x;
+            x->_parent = y;
+            y->_size = x->_size;
+            x->_size = Size(x->_left) + Size(x->_right) + 1;
+        }
+        /// @brief 右旋，x 的左子节点成为 x 的父节点
+        void RotateRight(Link *x)
+        {
+            Link *y = x->_left;
+            x->_left = y->_right;
+            if (y->_right != nullptr)
+                y->_right->_parent = x;
+            Replace(x, y);
+            y->_right = x;
+            x->_parent = y;
+            y->_size = x->_size;
+            x->_size = Size(x->_left) + Size(x->_right) + 1;
+        }
+        /// @brief 从节点池分配并构造节点，优先级取伪随机数
+        Link *NewNode(const T &value)
+        {
+            void *p = _pool.allocate();
+            Node *node;
+            try
+            {
+                node = new (p) Node(value);
+            }
+            catch (...)
+            {
+                _pool.deallocate(p);
+                throw;
+            }
+            node->_left = node->_right = node->_parent = nullptr;
+            node->_size = 1;
+            _seed ^= _seed << 13; // xorshift32
+            _seed ^= _seed >> 17;
+            _seed ^= _seed << 5;
+            node->_prio = _seed;
+            return node;
+        }
+        /// @brief 析构节点并归还节点池
+        void FreeNode(Node *node)
+        {
+            node->~Node();
+            _pool.deallocate(node);
+        }
+
+    private:
+        Link _head;                  ///< 哨兵，_next 为第一个元素，_prev 为最后一个元素
+        Link *_root;                 ///< 树根
+        uint32_t _seed;              ///< 优先级随机数状态
+        NodePool<Node, Alloc> _pool; ///< 节点池
+    };
+}
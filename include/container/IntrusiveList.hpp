@@ -0,0 +1,310 @@
+/// @file IntrusiveList.hpp
+/// @brief 侵入式双向链表：链接指针嵌在元素自身中
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace XuSTL
+{
+    /// @brief 嵌入元素中的链接钩子
+    /// @details 拷贝元素时钩子不随之拷贝，新元素处于未链接状态；
+    ///          元素在链表中时不能被销毁，须先从链表中移除。
+    struct IntrusiveListHook
+    {
+        IntrusiveListHook *_prev; ///< 前一个钩子
+        IntrusiveListHook *_next; ///< 后一个钩子
+
+        IntrusiveListHook() noexcept : _prev(nullptr), _next(nullptr) {}
+        IntrusiveListHook(const IntrusiveListHook &) noexcept : IntrusiveListHook() {}
+        IntrusiveListHook &operator=(const IntrusiveListHook &) noexcept { return *this; }
+        /// @brief 是否在某个链表中
+        bool is_linked() const { return _next != nullptr; }
+    };
+
+    /// @brief 钩子与元素之间的换算
+    /// @tparam T 元素类型
+    /// @tparam Hook 钩子成员指针
+    template <class T, IntrusiveListHook T::*Hook>
+    struct IntrusiveListTraits
+    {
+        /// @brief 钩子在元素中的偏移，Hook 是编译期常量，编译器会把它折叠成常数
+        static size_t offset()
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+            T *p = reinterpret_cast<T *>(&buf);
+            return static_cast<size_t>(reinterpret_cast<char *>(&(p->*Hook)) - reinterpret_cast<char *>(p));
+        }
+        /// @brief 由钩子得到所在元素
+        static T *to_value(IntrusiveListHook *hook)
+        {
+            return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - offset());
+        }
+    };
+
+    template <class T, IntrusiveListHook T::*Hook>
+    class IntrusiveList;
+    /// @brief 侵入式链表迭代器
+    /// @tparam T 元素类型
+    /// @tparam Hook 钩子成员指针
+    /// @tparam Ref 数据引用
+    /// @tparam Ptr 数据指针
+    template <class T, IntrusiveListHook T::*Hook, class Ref = T &, class Ptr = T *>
+    class IntrusiveListIterator
+    {
+        friend class IntrusiveList<T, Hook>;                   ///< 允许 IntrusiveList 访问私有成员
+        using Self = IntrusiveListIterator<T, Hook, Ref, Ptr>; ///< 自身类型
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag; ///< 迭代器类别
+        using value_type = T;                                       ///< 数据类型
+        using difference_type = std::ptrdiff_t;                     ///< 距离类型
+        using pointer = Ptr;                                        ///< 数据指针
+        using reference = Ref;                                      ///< 数据引用
+
+        /// @brief 构造函数
+        /// @param hook 当前钩子
+        IntrusiveListIterator(IntrusiveListHook *hook = nullptr) : _hook(hook) {}
+        /**
+         * @brief 解引用操作符，返回当前元素
+         * @return 当前元素的引用
+         */
+        Ref operator*() const
+        {
+            XUSTL_DEBUG_CHECK(_hook != nullptr, "解引用无效的侵入式链表迭代器！");
+            return *IntrusiveListTraits<T, Hook>::to_value(_hook);
+        }
+        /**
+         * @brief 箭头操作符，返回当前元素的指针
+         * @return 当前元素的指针
+         */
+        Ptr operator->() const { return &**this; }
+        Self &operator++()
+        {
+            _hook = _hook->_next;
+            return *this;
+        }
+        Self operator++(int)
+        {
+            Self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+        Self &operator--()
+        {
+            _hook = _hook->_prev;
+            return *this;
+        }
+        Self operator--(int)
+        {
+            Self tmp = *this;
+            --(*this);
+            return tmp;
+        }
+        bool operator==(const Self &other) const { return _hook == other._hook; }
+        bool operator!=(const Self &other) const { return _hook != other._hook; }
+
+    private:
+        IntrusiveListHook *_hook; ///< 当前钩子
+    };
+
+    /// @brief 侵入式双向链表
+    /// @details 链表不拥有元素，也不分配内存：push/insert/erase 只修改元素中钩子的指针。
+    ///          已知元素引用即可 O(1) 移除。一个钩子同一时刻只能在一个链表中，
+    ///          元素需要同时在多个链表中时可以嵌入多个钩子。
+    /// @tparam T 元素类型
+    /// @tparam Hook 元素中钩子成员的指针，如 &Conn::hook
+    template <class T, IntrusiveListHook T::*Hook>
+    class IntrusiveList
+    {
+        using traits = IntrusiveListTraits<T, Hook>; ///< 钩子换算
+
+    public:
+        using iterator = IntrusiveListIterator<T, Hook>;                                     ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;                        ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>; ///< const 反向迭代器
+        // 迭代器相关
+        iterator begin() { return iterator(_head._next); }
+        iterator end() { return iterator(&_head); }
+        const_iterator begin() const { return const_iterator(iterator(_head._next)); }
+        const_iterator end() const { return const_iterator(iterator(const_cast<IntrusiveListHook *>(&_head))); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(const_cast<IntrusiveListHook *>(&_head))); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_head._next)); }
+
+        // 构造函数和析构函数
+        IntrusiveList() : _size(0) { Init(); }
+        IntrusiveList(const IntrusiveList &) = delete;
+        IntrusiveList &operator=(const IntrusiveList &) = delete;
+        /**
+         * @brief 移动构造函数，接管另一个链表的全部元素
+         * @param other 另一个链表，之后为空
+         */
+        IntrusiveList(IntrusiveList &&other) noexcept : _size(0)
+        {
+            Init();
+            splice(end(), other);
+        }
+        /**
+         * @brief 析构函数，断开全部元素，元素本身不受影响
+         */
+        ~IntrusiveList() { clear(); }
+
+        // 容量相关
+        /**
+         * @brief 获取链表的大小
+         * @return 元素个数
+         */
+        size_t size() const { return _size; }
+        /**
+         * @brief 检查链表是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _size == 0; }
+        /**
+         * @brief 断开全部元素，使它们可以再加入其他链表
+         */
+        void clear()
+        {
+            for (IntrusiveListHook *h = _head._next; h != &_head;)
+            {
+                IntrusiveListHook *next = h->_next;
+                h->_prev = h->_next = nullptr;
+                h = next;
+            }
+            Init();
+            _size = 0;
+        }
+
+        // 获取数据
+        /**
+         * @brief 获取第一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 第一个元素的引用
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *traits::to_value(_head._next);
+        }
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *traits::to_value(_head._next);
+        }
+        /**
+         * @brief 获取最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 最后一个元素的引用
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *traits::to_value(_head._prev);
+        }
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return *traits::to_value(_head._prev);
+        }
+        /**
+         * @brief 由元素得到指向它的迭代器，O(1)
+         * @param value 链表中的元素
+         * @return 指向该元素的迭代器
+         */
+        static iterator iterator_to(T &value) { return iterator(&(value.*Hook)); }
+
+        // 修改
+        /// @brief 把元素链接到末尾
+        /// @param value 未链接的元素
+        void push_back(T &value) { insert(end(), value); }
+        /// @brief 把元素链接到开头
+        /// @param value 未链接的元素
+        void push_front(T &value) { insert(begin(), value); }
+        /// @brief 断开最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(iterator(_head._prev));
+        }
+        /// @brief 断开第一个元素，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            erase(begin());
+        }
+        /// @brief 把元素链接到 pos 之前，定义 XUSTL_DEBUG 时检查元素是否已在链表中
+        /// @param pos 插入位置
+        /// @param value 未链接的元素
+        /// @return 指向该元素的迭代器
+        iterator insert(iterator pos, T &value)
+        {
+            IntrusiveListHook *h = &(value.*Hook);
+            XUSTL_DEBUG_CHECK(!h->is_linked(), "元素已在链表中！");
+            IntrusiveListHook *next = pos._hook;
+            h->_prev = next->_prev;
+            h->_next = next;
+            next->_prev->_next = h;
+            next->_prev = h;
+            ++_size;
+            return iterator(h);
+        }
+        /// @brief 断开 pos 处的元素
+        /// @param pos 指定位置
+        /// @return 下一个元素的迭代器
+        iterator erase(iterator pos)
+        {
+            IntrusiveListHook *h = pos._hook;
+            XUSTL_DEBUG_CHECK(h != &_head && h->is_linked(), "删除无效的位置！");
+            IntrusiveListHook *next = h->_next;
+            h->_prev->_next = next;
+            next->_prev = h->_prev;
+            h->_prev = h->_next = nullptr;
+            --_size;
+            return iterator(next);
+        }
+        /// @brief 断开指定元素，O(1)
+        /// @param value 当前链表中的元素
+        void erase(T &value) { erase(iterator_to(value)); }
+        /// @brief 把 other 的全部元素移动到 pos 之前，O(1)
+        /// @param pos 插入位置
+        /// @param other 另一个链表，之后为空
+        void splice(iterator pos, IntrusiveList &other)
+        {
+            if (this == &other || other.empty())
+                return;
+            IntrusiveListHook *first = other._head._next;
+            IntrusiveListHook *last = other._head._prev;
+            IntrusiveListHook *next = pos._hook;
+            first->_prev = next->_prev;
+            next->_prev->_next = first;
+            last->_next = next;
+            next->_prev = last;
+            _size += other._size;
+            other.Init();
+            other._size = 0;
+        }
+        /// @brief 交换两个链表
+        /// @param other 另一个链表
+        void swap(IntrusiveList &other) noexcept
+        {
+            IntrusiveList tmp;
+            tmp.splice(tmp.end(), other);
+            other.splice(other.end(), *this);
+            splice(end(), tmp);
+        }
+
+    private:
+        /// @brief 把哨兵置为空链表
+        void Init() { _head._prev = _head._next = &_head; }
+
+    private:
+        IntrusiveListHook _head; ///< 哨兵，_next 为第一个元素，_prev 为最后一个元素
+        size_t _size;            ///< 元素个数
+    };
+}
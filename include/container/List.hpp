@@ -4,8 +4,14 @@
 #include "../adapter/ReverseIterator.hpp"
 #include "../adapter/ConstIterator.hpp"
 #include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/NodePool.hpp"
+#include "../utility/Debug.hpp"
+#include "../utility/Serialize.hpp"
 #include <iostream>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <type_traits>
 
 namespace XuSTL
 {
@@ -24,7 +30,8 @@ namespace XuSTL
     };
     /// @brief 前向声明
     /// @tparam T 数据类型
-    template <class T>
+    /// @tparam Alloc 分配器
+    template <class T, class Alloc = std::allocator<T>>
     class List;
     /// @brief 链表迭代器
     /// @tparam T 数据类型
@@ -33,7 +40,8 @@ namespace XuSTL
     template <class T, class Ref = T &, class Ptr = T *>
     class ListIterator
     {
-        friend class List<T>; ///< 允许 List 访问 ListIterator 的私有成员
+        template <class, class>
+        friend class List; ///< 允许 List 访问 ListIterator 的私有成员
 
     private:
         using Node = ListNode<T> *;             ///< 指向 ListNode 的指针类型
@@ -76,6 +84,7 @@ namespace XuSTL
          */
         Ref operator*() const
         {
+            XUSTL_DEBUG_CHECK(_pnode != nullptr, "解引用无效的链表迭代器！");
             return _pnode->_data;
         }
         /**
@@ -84,6 +93,7 @@ namespace XuSTL
          */
         Ptr operator->()
         {
+            XUSTL_DEBUG_CHECK(_pnode != nullptr, "解引用无效的链表迭代器！");
             return &_pnode->_data;
         }
         Self &operator++()
@@ -119,40 +129,53 @@ namespace XuSTL
 
     /// @brief 双向链表
     /// @tparam T 数据类型
-    template <class T>
+    /// @tparam Alloc 分配器，头节点和节点池的块都通过它申请
+    template <class T, class Alloc>
     class List
     {
     private:
-        using Node = ListNode<T>;    ///< 节点类型
-        using PNode = ListNode<T> *; ///< 节点指针类型
-        using Ref = T &;             ///< 数据引用类型
-        using Ptr = T *;             ///< 数据指针类型
+        using Node = ListNode<T>;                                                                  ///< 节点类型
+        using PNode = ListNode<T> *;                                                               ///< 节点指针类型
+        using Ref = T &;                                                                           ///< 数据引用类型
+        using Ptr = T *;                                                                           ///< 数据指针类型
+        using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>; ///< 节点分配器
+        using node_traits = std::allocator_traits<node_allocator>;                                 ///< 节点分配器萃取
 
     public:
+        using allocator_type = Alloc; ///< 分配器类型
         // 迭代器相关
         using iterator = ListIterator<T, Ref, Ptr>;
-        using const_iterator = ConstIterator<iterator, iterator &, iterator *>;
-        using reverse_iterator = ReverseIterator<iterator, iterator &, iterator *>;
-        using const_reverse_iterator = ConstReverseIterator<iterator, iterator &, iterator *>;
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>;
         iterator begin() { return iterator(_phead->_next); }
         iterator end() { return iterator(nullptr); }
-        const_iterator begin() const { return const_iterator(begin()); }
-        const_iterator end() const { return const_iterator(end()); }
+        const_iterator begin() const { return const_iterator(iterator(_phead->_next)); }
+        const_iterator end() const { return const_iterator(iterator(nullptr)); }
         reverse_iterator rbegin() { return reverse_iterator(end()); }
         reverse_iterator rend() { return reverse_iterator(begin()); }
-        const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
-        const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(nullptr)); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_phead->_next)); }
         // 构造函数和析构函数
         List() : _size(0), _phead(nullptr)
         {
             CreateHead();
         }
+        /**
+         * @brief 使用指定分配器构造空链表
+         * @param alloc 分配器
+         */
+        explicit List(const Alloc &alloc) : _size(0), _phead(nullptr), _pool(alloc)
+        {
+            CreateHead();
+        }
         /**
          * @brief 指定数量和初始值构造链表
          * @param n 初始化节点数量
          * @param value 节点初始值
+         * @param alloc 分配器
          */
-        List(int n, const T &value = T())
+        List(int n, const T &value = T(), const Alloc &alloc = Alloc()) : _size(0), _phead(nullptr), _pool(alloc)
         {
             CreateHead();
             while (n--)
@@ -163,9 +186,11 @@ namespace XuSTL
          * @tparam T_iterator 迭代器类型
          * @param first 开始迭代器
          * @param end 结束迭代器
+         * @param alloc 分配器
          */
-        template <class T_iterator>
-        List(T_iterator first, T_iterator end)
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        List(T_iterator first, T_iterator end, const Alloc &alloc = Alloc()) : _size(0), _phead(nullptr), _pool(alloc)
         {
             CreateHead();
             while (first != end)
@@ -175,7 +200,9 @@ namespace XuSTL
          * @brief 拷贝构造函数
          * @param other 另一个链表
          */
-        List(const List<T> &other)
+        List(const List &other)
+            : _size(0), _phead(nullptr),
+              _pool(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.get_allocator()))
         {
             CreateHead();
             for (auto &val : other)
@@ -185,41 +212,43 @@ namespace XuSTL
          * @brief 移动构造函数
          * @param other 另一个链表
          */
-        List(List<T> &&other) : _size(other._size), _phead(other._phead)
+        List(List &&other) : _size(other._size), _phead(other._phead), _pool(std::move(other._pool))
         {
             other._phead = nullptr;
-            other.size = 0;
+            other._size = 0;
         }
         /**
          * @brief 初始化列表构造函数
          * @param list 初始化列表
+         * @param alloc 分配器
          */
-        List(const std::initializer_list<T> &list) : List(list.begin(), list.end()) {}
+        List(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : List(list.begin(), list.end(), alloc) {}
         /**
          * @brief 析构函数
          */
         ~List()
         {
             clear();
-            delete _phead;
+            DestroyHead();
         }
 
         // 重载
-        List<T> &operator=(const List<T> &other)
+        List &operator=(const List &other)
         {
-            for (auto &val : other)
-                push_back(val);
+            if (this != &other)
+            {
+                List tmp(other);
+                swap(tmp);
+            }
+            return *this;
         }
-        List<T> &operator=(List<T> &&other) noexcept
+        List &operator=(List &&other) noexcept
         {
-            clear();
-            _size = other._size;
-            _phead = other._phead;
-            other.size = 0;
-            other._phead = nullptr;
+            List tmp(std::move(other));
+            swap(tmp);
             return *this;
         }
-        bool operator==(const List<T> &other)
+        bool operator==(const List &other)
         {
             if (_size != other._size)
                 return false;
@@ -230,16 +259,32 @@ namespace XuSTL
                     return false;
             return true;
         }
-        bool operator!=(const List<T> &other) { return !(*this == other); }
+        bool operator!=(const List &other) { return !(*this == other); }
+        /**
+         * @brief 返回指定位置的元素，需要从头遍历，O(n)；定义 XUSTL_DEBUG 时检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         */
         Ref operator[](size_t pos)
         {
-            if (pos >= _size)
-                throw std::out_of_range("越界访问！");
+            XUSTL_DEBUG_CHECK(pos < _size, "越界访问！");
             auto it = begin();
             for (size_t i = 0; i < pos; ++i)
-                --it;
+                ++it;
             return *it;
         }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         * @throws std::out_of_range 如果 pos 越界
+         */
+        Ref at(size_t pos)
+        {
+            if (pos >= _size)
+                throw std::out_of_range("越界访问！");
+            return (*this)[pos];
+        }
 
         // 容量相关
         /**
@@ -247,60 +292,66 @@ namespace XuSTL
          * @return 链表中元素的数量
          */
         size_t size() const { return _size; }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return _pool.get_allocator(); }
         /**
          * @brief 检查链表是否为空
          * @return 如果链表为空返回 true，否则返回 false
          */
         bool empty() const { return _size == 0; }
         /**
-         * @brief 清空链表
+         * @brief 清空链表，析构全部元素后整块归还节点内存
          */
         void clear()
         {
-            while (!empty())
-                pop_back();
+            if (empty())
+                return;
+            DestroyNodes(std::is_trivially_destructible<T>());
+            _phead->_next = nullptr;
+            _phead->_prev = _phead;
+            _size = 0;
+            _pool.release();
         }
 
         // 获取数据
         /**
-         * @brief 获取链表的第一个元素
+         * @brief 获取链表的第一个元素，定义 XUSTL_DEBUG 时检查是否为空
          * @return 第一个元素的引用
-         * @throws std::out_of_range 当链表为空时抛出异常
          */
         Ref front()
         {
-            if (empty())
-                throw std::out_of_range("链表为空！");
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
             return _phead->_next->_data;
         }
         /**
-         * @brief 获取链表的第一个元素
+         * @brief 获取链表的第一个元素，定义 XUSTL_DEBUG 时检查是否为空
          * @return 第一个元素的const引用
-         * @throws std::out_of_range 当链表为空时抛出异常
          */
-        const Ref front() const
+        const T &front() const
         {
-            return front();
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return _phead->_next->_data;
         }
         /**
-         * @brief 获取链表的最后一个元素
+         * @brief 获取链表的最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
          * @return 最后一个元素的引用
-         * @throws std::out_of_range 当链表为空时抛出异常
          */
         Ref back()
         {
-            if (empty())
-                throw std::out_of_range("链表为空！");
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
             return _phead->_prev->_data;
         }
         /**
-         * @brief 获取链表的最后一个元素
+         * @brief 获取链表的最后一个元素，定义 XUSTL_DEBUG 时检查是否为空
          * @return 最后一个元素的const引用
-         * @throws std::out_of_range 当链表为空时抛出异常
          */
-        const Ref back() const
+        const T &back() const
         {
-            return back();
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
+            return _phead->_prev->_data;
         }
 
         // 修改
@@ -309,7 +360,7 @@ namespace XuSTL
         /// @param value 数据
         void push_back(const T &value)
         {
-            PNode newNode = new Node(value);
+            PNode newNode = NewNode(value);
             if (_size == 0)
             {
                 _phead->_next = newNode;
@@ -325,23 +376,22 @@ namespace XuSTL
             }
             ++_size;
         }
-        /// @brief 尾删
+        /// @brief 尾删，定义 XUSTL_DEBUG 时检查是否为空
         void pop_back()
         {
-            if (empty())
-                throw std::out_of_range("链表为空！");
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
             PNode tail = _phead->_prev;
             PNode newTail = tail->_prev;
             newTail->_next = nullptr;
             _phead->_prev = newTail;
-            delete tail;
+            FreeNode(tail);
             --_size;
         }
         /// @brief 头插
         /// @param value 数据
         void push_front(const T &value)
         {
-            PNode newNode = new Node(value);
+            PNode newNode = NewNode(value);
             if (_size == 0)
             {
                 _phead->_next = newNode;
@@ -358,18 +408,17 @@ namespace XuSTL
             }
             ++_size;
         }
-        /// @brief 头删
+        /// @brief 头删，定义 XUSTL_DEBUG 时检查是否为空
         void pop_front()
         {
-            if (empty())
-                throw std::out_of_range("链表为空！");
+            XUSTL_DEBUG_CHECK(!empty(), "链表为空！");
             PNode headNext = _phead->_next;
             _phead->_next = headNext->_next;
             if (headNext->_next != nullptr)
                 headNext->_next->_prev = _phead;
             else
                 _phead->_prev = _phead; // 空链表
-            delete headNext;
+            FreeNode(headNext);
             --_size;
         }
         /// @brief 指定位置插入
@@ -378,7 +427,7 @@ namespace XuSTL
         /// @return 插入后的迭代器
         iterator insert(iterator pos, const T &value)
         {
-            PNode newNode = new Node(value);
+            PNode newNode = NewNode(value);
             PNode currentNode = pos._pnode;
             if (currentNode != nullptr)
             {
@@ -414,29 +463,383 @@ namespace XuSTL
                 _phead->_next = nextNode;
             if (currentNode == _phead->_prev)
                 _phead->_prev = prevNode;
-            delete currentNode;
+            FreeNode(currentNode);
             --_size;
             return iterator(nextNode);
         }
         /// @brief 交换两个链表
         /// @param other 另一个链表
-        void swap(List<T> &other) noexcept
+        void swap(List &other) noexcept
         {
             std::swap(_size, other._size);
             std::swap(_phead, other._phead);
+            _pool.swap(other._pool);
+        }
+
+        // 链表操作
+        /// @brief 把 other 的全部节点移动到 pos 之前，只修改指针，O(1)
+        /// @details 节点内存仍由原来的块持有，两个链表的节点池从此共享块的所有权。
+        ///          两个链表的分配器必须相等。
+        /// @param pos 插入位置
+        /// @param other 另一个链表，之后为空
+        void splice(iterator pos, List &other)
+        {
+            if (this == &other || other.empty())
+                return;
+            Adopt(other);
+            PNode first = other._phead->_next;
+            PNode last = other._phead->_prev;
+            other.Unlink(first, last);
+            LinkBefore(pos._pnode, first, last);
+            _size += other._size;
+            other._size = 0;
+        }
+        /// @brief 把 other 中 it 指向的节点移动到 pos 之前，O(1)，other 可以就是当前链表
+        /// @param pos 插入位置
+        /// @param other it 所在的链表
+        /// @param it 要移动的节点
+        void splice(iterator pos, List &other, iterator it)
+        {
+            PNode node = it._pnode;
+            XUSTL_DEBUG_CHECK(node != nullptr, "splice 的节点无效！");
+            if (this == &other && (node == pos._pnode || node->_next == pos._pnode))
+                return;
+            if (this != &other)
+                Adopt(other);
+            other.Unlink(node, node);
+            LinkBefore(pos._pnode, node, node);
+            --other._size;
+            ++_size;
+        }
+        /// @brief 把 other 中 [first, last) 的节点移动到 pos 之前
+        /// @details 同一链表内为 O(1)，pos 不能在 [first, last) 中；跨链表时需要数节点个数，O(区间长度)。
+        /// @param pos 插入位置
+        /// @param other 区间所在的链表
+        /// @param first 区间开始
+        /// @param last 区间结束
+        void splice(iterator pos, List &other, iterator first, iterator last)
+        {
+            if (first == last)
+                return;
+            PNode head = first._pnode;
+            PNode tail = last._pnode != nullptr ? last._pnode->_prev : other._phead->_prev;
+            if (this != &other)
+            {
+                Adopt(other);
+                size_t n = 1;
+                for (PNode node = head; node != tail; node = node->_next)
+                    ++n;
+                other._size -= n;
+                _size += n;
+            }
+            other.Unlink(head, tail);
+            LinkBefore(pos._pnode, head, tail);
+        }
+        /// @brief 把已按 comp 排好序的 other 合并进当前有序链表，只修改指针，稳定
+        /// @param other 另一个有序链表，之后为空
+        /// @param comp 比较函数，默认为小于
+        template <class Compare = std::less<T>>
+        void merge(List &other, Compare comp = Compare())
+        {
+            if (this == &other || other.empty())
+                return;
+            Adopt(other);
+            PNode a = _phead->_next;
+            PNode b = other._phead->_next;
+            while (a != nullptr && b != nullptr)
+            {
+                if (comp(b->_data, a->_data))
+                {
+                    PNode next = b->_next;
+                    LinkBefore(a, b, b);
+                    b = next;
+                }
+                else
+                    a = a->_next;
+            }
+            if (b != nullptr)
+                LinkBefore(nullptr, b, other._phead->_prev);
+            _size += other._size;
+            other._size = 0;
+            other._phead->_next = nullptr;
+            other._phead->_prev = other._phead;
+        }
+        /// @brief 自底向上归并排序，只重连节点指针，不分配内存，稳定，O(n log n)
+        /// @details 第 i 个槽存放长度为 2^i 的有序段，逐个取下节点像二进制进位一样合并。
+        /// @param comp 比较函数，默认为小于
+        template <class Compare = std::less<T>>
+        void sort(Compare comp = Compare())
+        {
+            if (_size < 2)
+                return;
+            // 排序期间只维护 _next，结束后统一修复 _prev
+            PNode bins[64];
+            size_t fill = 0;
+            for (PNode node = _phead->_next; node != nullptr;)
+            {
+                PNode carry = node;
+                node = node->_next;
+                carry->_next = nullptr;
+                size_t i = 0;
+                for (; i < fill && bins[i] != nullptr; ++i)
+                {
+                    carry = MergeRuns(bins[i], carry, comp); // bins[i] 中的元素更靠前
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                if (i == fill)
+                    ++fill;
+            }
+            PNode list = nullptr;
+            for (size_t i = 0; i < fill; ++i)
+                if (bins[i] != nullptr)
+                    list = MergeRuns(bins[i], list, comp);
+            PNode prev = _phead;
+            _phead->_next = list;
+            for (PNode node = list; node != nullptr; node = node->_next)
+            {
+                node->_prev = prev;
+                prev = node;
+            }
+            _phead->_prev = prev;
+        }
+        /// @brief 反转链表，只交换节点指针，O(n)
+        void reverse()
+        {
+            if (_size < 2)
+                return;
+            PNode first = _phead->_next;
+            PNode last = _phead->_prev;
+            for (PNode node = first; node != nullptr;)
+            {
+                PNode next = node->_next;
+                std::swap(node->_next, node->_prev);
+                node = next;
+            }
+            first->_next = nullptr;
+            last->_prev = _phead;
+            _phead->_next = last;
+            _phead->_prev = first;
+        }
+        /// @brief 删除相邻的重复元素，只保留第一个
+        /// @param pred 判等函数，默认为 ==
+        /// @return 删除的元素个数
+        template <class BinaryPredicate = std::equal_to<T>>
+        size_t unique(BinaryPredicate pred = BinaryPredicate())
+        {
+            size_t removed = 0;
+            for (PNode node = _phead->_next; node != nullptr && node->_next != nullptr;)
+            {
+                PNode next = node->_next;
+                if (pred(node->_data, next->_data))
+                {
+                    erase(iterator(next));
+                    ++removed;
+                }
+                else
+                    node = next;
+            }
+            return removed;
+        }
+
+        // 序列化
+        /// @brief 以二进制格式写入输出流
+        /// @param os 输出流
+        /// @throws std::runtime_error 写入失败时抛出
+        void serialize(std::ostream &os) const
+        {
+            StreamWriter w(os);
+            SerializeTo(w);
+        }
+        /// @brief 以二进制格式写入文件描述符，平凡可拷贝的元素按节点收集后用 writev 写出
+        /// @param fd 文件描述符
+        /// @throws std::system_error 写入失败时抛出
+        void serialize(int fd) const
+        {
+            FdWriter w(fd);
+            SerializeTo(w);
+        }
+        /// @brief 从输入流读取 serialize 写出的数据，替换当前内容
+        /// @param is 输入流
+        /// @throws std::runtime_error 数据不完整或格式不匹配时抛出
+        void deserialize(std::istream &is)
+        {
+            StreamReader r(is);
+            DeserializeFrom(r);
+        }
+        /// @brief 从文件描述符读取 serialize 写出的数据，替换当前内容
+        /// @param fd 文件描述符
+        /// @throws std::runtime_error 数据不完整或格式不匹配时抛出
+        /// @throws std::system_error 读取失败时抛出
+        void deserialize(int fd)
+        {
+            FdReader r(fd);
+            DeserializeFrom(r);
         }
 
     private:
+        /// @brief 写出文件头和全部元素
+        template <class Writer>
+        void SerializeTo(Writer &w) const
+        {
+            const bool bulk = std::is_trivially_copyable<T>::value;
+            WriteSerialHeader(w, SerialKind::List, bulk, sizeof(T), _size);
+            if (bulk)
+            {
+                struct iovec iov[IOV_MAX];
+                size_t cnt = 0;
+                for (PNode node = _phead->_next; node != nullptr; node = node->_next)
+                {
+                    iov[cnt].iov_base = &node->_data;
+                    iov[cnt].iov_len = sizeof(T);
+                    if (++cnt == IOV_MAX)
+                    {
+                        w.write_gather(iov, cnt);
+                        cnt = 0;
+                    }
+                }
+                w.write_gather(iov, cnt);
+            }
+            else
+            {
+                for (PNode node = _phead->_next; node != nullptr; node = node->_next)
+                    Serializer<T>::write(w, node->_data);
+            }
+            w.flush();
+        }
+        /// @brief 读取文件头和全部元素
+        template <class Reader>
+        void DeserializeFrom(Reader &r)
+        {
+            SerialHeader h = ReadSerialHeader(r, SerialKind::List, sizeof(T), std::is_trivially_copyable<T>::value);
+            clear();
+            for (size_t i = 0; i < h.count; i++)
+            {
+                T value;
+                Serializer<T>::read(r, value);
+                push_back(value);
+            }
+        }
+
         /// @brief 创建头节点
         void CreateHead()
         {
-            _phead = new Node();
+            node_allocator a(_pool.get_allocator());
+            PNode head = node_traits::allocate(a, 1);
+            try
+            {
+                node_traits::construct(a, head);
+            }
+            catch (...)
+            {
+                node_traits::deallocate(a, head, 1);
+                throw;
+            }
+            _phead = head;
             _phead->_next = nullptr;
             _phead->_prev = _phead;
         }
+        /// @brief 销毁头节点
+        void DestroyHead()
+        {
+            if (_phead == nullptr)
+                return;
+            node_allocator a(_pool.get_allocator());
+            node_traits::destroy(a, _phead);
+            node_traits::deallocate(a, _phead, 1);
+            _phead = nullptr;
+        }
+        /// @brief 从节点池分配并构造节点
+        /// @param value 数据
+        /// @return 新节点
+        PNode NewNode(const T &value)
+        {
+            void *p = _pool.allocate();
+            try
+            {
+                return new (p) Node(value);
+            }
+            catch (...)
+            {
+                _pool.deallocate(p);
+                throw;
+            }
+        }
+        /// @brief 析构节点并归还节点池
+        /// @param node 节点
+        void FreeNode(PNode node)
+        {
+            node->~Node();
+            _pool.deallocate(node);
+        }
+        /// @brief 共享 other 的节点池，使 other 的节点可以转移过来
+        /// @param other 另一个链表
+        void Adopt(List &other)
+        {
+            XUSTL_DEBUG_CHECK(get_allocator() == other.get_allocator(), "两个链表的分配器不相等！");
+            _pool.share(other._pool);
+        }
+        /// @brief 把 [first, last] 这段节点从当前链表摘下，不修改 _size
+        /// @param first 第一个节点
+        /// @param last 最后一个节点
+        void Unlink(PNode first, PNode last)
+        {
+            PNode prev = first->_prev;
+            PNode next = last->_next;
+            prev->_next = next;
+            if (next != nullptr)
+                next->_prev = prev;
+            else
+                _phead->_prev = prev;
+        }
+        /// @brief 把 [first, last] 这段节点接到 pos 之前，不修改 _size
+        /// @param pos 插入位置，nullptr 表示末尾
+        /// @param first 第一个节点
+        /// @param last 最后一个节点
+        void LinkBefore(PNode pos, PNode first, PNode last)
+        {
+            PNode prev = pos != nullptr ? pos->_prev : _phead->_prev;
+            prev->_next = first;
+            first->_prev = prev;
+            last->_next = pos;
+            if (pos != nullptr)
+                pos->_prev = last;
+            else
+                _phead->_prev = last;
+        }
+        /// @brief 合并两条以 nullptr 结尾的有序单链，相等时 a 在前
+        /// @return 合并后的头节点
+        template <class Compare>
+        static PNode MergeRuns(PNode a, PNode b, Compare &comp)
+        {
+            PNode head = nullptr;
+            PNode *tail = &head;
+            while (a != nullptr && b != nullptr)
+            {
+                if (comp(b->_data, a->_data))
+                    *tail = b, b = b->_next;
+                else
+                    *tail = a, a = a->_next;
+                tail = &(*tail)->_next;
+            }
+            *tail = a != nullptr ? a : b;
+            return head;
+        }
+        /// @brief 析构全部元素节点，元素可平凡析构时无需遍历
+        void DestroyNodes(std::true_type) {}
+        void DestroyNodes(std::false_type)
+        {
+            for (PNode node = _phead->_next; node != nullptr;)
+            {
+                PNode next = node->_next;
+                node->~Node();
+                node = next;
+            }
+        }
 
     private:
-        size_t _size; ///< 元素个数
-        PNode _phead; ///< 头节点指针
+        size_t _size;                ///< 元素个数
+        PNode _phead;                ///< 头节点指针
+        NodePool<Node, Alloc> _pool; ///< 元素节点池
     };
 }
\ No newline at end of file
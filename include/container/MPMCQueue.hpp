@@ -0,0 +1,256 @@
+/// @file MPMCQueue.hpp
+/// @brief 多生产者多消费者有界无锁队列
+#pragma once
+#include "../utility/CacheLine.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 多生产者多消费者有界无锁队列
+    /// @details 固定容量的环形缓冲区，容量向上取整到 2 的幂。每个槽位带一个序号：
+    ///          序号等于入队位置时槽位可写，等于入队位置加一时可读，出队后加上容量留给下一轮。
+    ///          生产者和消费者各自用 CAS 抢占位置，只在抢到的槽位上同步，互不加锁。
+    ///          push/pop 是阻塞版本，先自旋重试，仍不成功才在条件变量上休眠；
+    ///          try_ 版本和阻塞版本成功后只有在确实有线程休眠时才去加锁唤醒。
+    ///          元素必须能不抛异常地移动，否则抢到槽位后构造失败会使槽位永远不可读。
+    /// @tparam T 数据类型
+    /// @tparam Alloc 分配器，会被重绑定到内部的槽位类型
+    template <class T, class Alloc = std::allocator<T>>
+    class alignas(CacheLineSize) MPMCQueue
+    {
+        static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                      "MPMCQueue 要求元素能不抛异常地移动");
+        /// @brief 槽位
+        struct Cell
+        {
+            std::atomic<size_t> _seq;                                             ///< 序号
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage; ///< 元素
+        };
+        /// @brief 阻塞等待的线程在这里休眠
+        struct Parking
+        {
+            std::mutex _mutex;                ///< 保护休眠与唤醒之间的检查
+            std::condition_variable _cv;      ///< 条件变量
+            std::atomic<size_t> _waiters{0}; ///< 休眠中的线程数
+        };
+        using cell_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Cell>; ///< 槽位分配器
+        using cell_traits = std::allocator_traits<cell_allocator>;                                   ///< 槽位分配器萃取
+
+        static const int SpinCount = 64; ///< 阻塞操作休眠前的自旋重试次数
+
+    public:
+        using value_type = T;         ///< 数据类型
+        using allocator_type = Alloc; ///< 分配器类型
+
+        /**
+         * @brief 构造函数
+         * @param capacity 容量，向上取整到 2 的幂，至少为 2
+         * @param alloc 分配器
+         */
+        explicit MPMCQueue(size_t capacity, const Alloc &alloc = Alloc())
+            : _cap(RoundUp(capacity)), _alloc(alloc), _enqueue_pos(0), _dequeue_pos(0)
+        {
+            _cells = cell_traits::allocate(_alloc, _cap);
+            for (size_t i = 0; i < _cap; i++)
+                ::new (static_cast<void *>(&_cells[i]._seq)) std::atomic<size_t>(i);
+        }
+        MPMCQueue(const MPMCQueue &) = delete;
+        MPMCQueue &operator=(const MPMCQueue &) = delete;
+        /**
+         * @brief 析构函数，析构剩余元素，此时不能再有线程访问队列
+         */
+        ~MPMCQueue()
+        {
+            for (size_t pos = _dequeue_pos.load(std::memory_order_relaxed); pos != _enqueue_pos.load(std::memory_order_relaxed); ++pos)
+            {
+                Cell &cell = _cells[pos & (_cap - 1)];
+                if (cell._seq.load(std::memory_order_relaxed) == pos + 1)
+                    Value(cell)->~T();
+            }
+            cell_traits::deallocate(_alloc, _cells, _cap);
+        }
+
+        // 非阻塞
+        /// @brief 尝试入队，队列满时立即返回
+        /// @param value 数据
+        /// @return 成功返回 true，队列满返回 false
+        bool try_push(const T &value) { return try_push(T(value)); }
+        /// @brief 尝试入队（移动），队列满时立即返回，失败时 value 不被移走
+        /// @param value 数据的右值
+        /// @return 成功返回 true，队列满返回 false
+        bool try_push(T &&value)
+        {
+            if (!Enqueue(value))
+                return false;
+            Wake(_not_empty);
+            return true;
+        }
+        /// @brief 尝试出队，队列空时立即返回
+        /// @param out 接收出队元素
+        /// @return 成功返回 true，队列空返回 false
+        bool try_pop(T &out)
+        {
+            if (!Dequeue(out))
+                return false;
+            Wake(_not_full);
+            return true;
+        }
+
+        // 阻塞
+        /// @brief 入队，队列满时等待
+        /// @param value 数据
+        void push(const T &value) { push(T(value)); }
+        /// @brief 入队（移动），队列满时等待
+        /// @param value 数据的右值
+        void push(T &&value)
+        {
+            Block(_not_full, [&]()
+                  { return Enqueue(value); });
+            Wake(_not_empty);
+        }
+        /// @brief 出队，队列空时等待
+        /// @param out 接收出队元素
+        void pop(T &out)
+        {
+            Block(_not_empty, [&]()
+                  { return Dequeue(out); });
+            Wake(_not_full);
+        }
+
+        // 容量相关
+        /**
+         * @brief 获取元素个数，并发时只是近似值
+         * @return 元素个数
+         */
+        size_t size() const
+        {
+            size_t tail = _enqueue_pos.load(std::memory_order_acquire);
+            size_t head = _dequeue_pos.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+        /**
+         * @brief 检查是否为空，并发时只是近似值
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return size() == 0; }
+        /**
+         * @brief 获取容量
+         * @return 容量，2 的幂
+         */
+        size_t capacity() const { return _cap; }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return Alloc(_alloc); }
+
+    private:
+        /// @brief 向上取整到 2 的幂，至少为 2
+        static size_t RoundUp(size_t n)
+        {
+            size_t cap = 2;
+            while (cap < n)
+                cap <<= 1;
+            return cap;
+        }
+        /// @brief 槽位中的元素
+        static T *Value(Cell &cell) { return reinterpret_cast<T *>(&cell._storage); }
+        /// @brief 抢占一个可写槽位并把 value 移入，不唤醒
+        bool Enqueue(T &value)
+        {
+            size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;)
+            {
+                cell = &_cells[pos & (_cap - 1)];
+                size_t seq = cell->_seq.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false; // 上一轮的元素还没被取走，队列满
+                else
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+            ::new (static_cast<void *>(Value(*cell))) T(std::move(value));
+            cell->_seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        /// @brief 抢占一个可读槽位并把元素移出，不唤醒
+        bool Dequeue(T &out)
+        {
+            size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;)
+            {
+                cell = &_cells[pos & (_cap - 1)];
+                size_t seq = cell->_seq.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false; // 这一轮的元素还没写入，队列空
+                else
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+            T *value = Value(*cell);
+            out = std::move(*value);
+            value->~T();
+            cell->_seq.store(pos + _cap, std::memory_order_release);
+            return true;
+        }
+        /// @brief 反复执行 op 直到成功：先自旋，再在 parking 上休眠
+        /// @details 休眠前登记到 _waiters 后再检查一次，与 Wake 中先发布再读 _waiters 配对，不会漏掉唤醒。
+        template <class Op>
+        void Block(Parking &parking, Op op)
+        {
+            for (int i = 0; i < SpinCount; i++)
+            {
+                if (op())
+                    return;
+                if (i >= SpinCount / 2)
+                    std::this_thread::yield();
+            }
+            std::unique_lock<std::mutex> lock(parking._mutex);
+            parking._waiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!op())
+                parking._cv.wait(lock);
+            parking._waiters.fetch_sub(1);
+        }
+        /// @brief 有线程在 parking 上休眠时唤醒一个
+        void Wake(Parking &parking)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parking._waiters.load(std::memory_order_relaxed) == 0)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(parking._mutex); // 等待方检查完、进入 wait 之后才能通知
+            }
+            parking._cv.notify_one();
+        }
+
+    private:
+        Cell *_cells;                                            ///< 槽位，构造后只读
+        size_t _cap;                                             ///< 容量，构造后只读
+        cell_allocator _alloc;                                   ///< 槽位分配器
+        alignas(CacheLineSize) std::atomic<size_t> _enqueue_pos; ///< 下一个入队位置
+        alignas(CacheLineSize) std::atomic<size_t> _dequeue_pos; ///< 下一个出队位置
+        alignas(CacheLineSize) Parking _not_full;                ///< 等待队列不满的生产者
+        Parking _not_empty;                                      ///< 等待队列不空的消费者
+    };
+}
@@ -0,0 +1,471 @@
+/// @file MmapVector.hpp
+/// @brief 文件映射的动态数组
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/GrowthPolicy.hpp"
+#include "../utility/Debug.hpp"
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace XuSTL
+{
+    /// @brief 文件打开方式
+    enum class MmapMode
+    {
+        ReadOnly,  ///< 只读映射，打开时不拷贝任何数据
+        ReadWrite, ///< 读写映射，文件不存在时创建
+        Create     ///< 读写映射，清空已有文件
+    };
+
+    /**
+     * @brief 以文件为存储的动态数组，接口与 Vector 一致。
+     *
+     * 文件内容就是元素的原始字节，size() = 文件长度 / sizeof(T)。
+     * 打开时用 mmap 直接映射，不读取也不拷贝数据；扩容时 ftruncate 文件后用 mremap 扩展映射。
+     * 读写模式下文件在使用期间会被扩展到容量大小，关闭时截断回 size()。
+     * 只读模式下请通过 const 引用访问元素；可写的访问接口总是检查并抛出 std::logic_error，
+     * 不会交出指向 PROT_READ 映射的可写引用。
+     *
+     * @tparam T 元素类型，必须是平凡可拷贝类型
+     * @tparam Growth 扩容策略，默认为按页取整的 2 倍扩容
+     */
+    template <class T, class Growth = PageGrowth<4096, GeometricGrowth<2, 1>>>
+    class MmapVector
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "MmapVector 只能存放平凡可拷贝类型");
+
+    public:
+        using iterator = T *;                                          ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator>;            ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator>; ///< const 反向迭代器
+        // 迭代器相关
+        /**
+         * @brief 返回指向第一个元素的迭代器，只读映射时抛出异常。
+         * @return 指向第一个元素的迭代器。
+         * @throws std::logic_error 只读映射时抛出。
+         */
+        iterator begin()
+        {
+            CheckMutableAccess();
+            return _start;
+        }
+        /**
+         * @brief 返回指向最后一个元素之后的迭代器，只读映射时抛出异常。
+         * @return 指向最后一个元素之后的迭代器。
+         * @throws std::logic_error 只读映射时抛出。
+         */
+        iterator end()
+        {
+            CheckMutableAccess();
+            return _start + _size;
+        }
+        /**
+         * @brief 返回指向第一个元素的 const 迭代器。
+         * @return 指向第一个元素的 const 迭代器。
+         */
+        const_iterator begin() const { return const_iterator(_start); }
+        /**
+         * @brief 返回指向最后一个元素之后的 const 迭代器。
+         * @return 指向最后一个元素之后的 const 迭代器。
+         */
+        const_iterator end() const { return const_iterator(_start + _size); }
+        /**
+         * @brief 返回指向最后一个元素的反向迭代器。
+         * @return 指向最后一个元素的反向迭代器。
+         */
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        /**
+         * @brief 返回指向第一个元素之前的反向迭代器。
+         * @return 指向第一个元素之前的反向迭代器。
+         */
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        /**
+         * @brief 返回指向最后一个元素的 const 反向迭代器。
+         * @return 指向最后一个元素的 const 反向迭代器。
+         */
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(_start + _size); }
+        /**
+         * @brief 返回指向第一个元素之前的 const 反向迭代器。
+         * @return 指向第一个元素之前的 const 反向迭代器。
+         */
+        const_reverse_iterator crend() const { return const_reverse_iterator(_start); }
+
+        // 构造函数和析构函数
+        /**
+         * @brief 默认构造函数，不关联任何文件。
+         */
+        MmapVector() : _start(nullptr), _size(0), _capacity(0), _fd(-1), _mode(MmapMode::ReadOnly) {}
+        /**
+         * @brief 打开并映射文件。
+         * @param path 文件路径。
+         * @param mode 打开方式。
+         * @throws std::system_error 打开或映射失败时抛出。
+         * @throws std::runtime_error 文件长度不是 sizeof(T) 的整数倍时抛出。
+         */
+        explicit MmapVector(const char *path, MmapMode mode = MmapMode::ReadWrite) : MmapVector()
+        {
+            open(path, mode);
+        }
+        MmapVector(const MmapVector &) = delete;
+        MmapVector &operator=(const MmapVector &) = delete;
+        /**
+         * @brief 移动构造函数，接管映射和文件描述符。
+         * @param other 另一个 MmapVector，移动后不再关联文件。
+         */
+        MmapVector(MmapVector &&other) noexcept : MmapVector()
+        {
+            swap(other);
+        }
+        /**
+         * @brief 移动赋值运算符重载。
+         * @param other 另一个 MmapVector。
+         * @return 当前 MmapVector 的引用。
+         */
+        MmapVector &operator=(MmapVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+                swap(other);
+            }
+            return *this;
+        }
+        /**
+         * @brief 析构函数，关闭文件，截断失败时忽略错误。
+         */
+        ~MmapVector()
+        {
+            Release();
+        }
+
+        // 文件操作
+        /**
+         * @brief 打开并映射文件，之前关联的文件会先关闭。
+         * @param path 文件路径。
+         * @param mode 打开方式。
+         * @throws std::system_error 打开或映射失败、或截断之前的文件失败时抛出。
+         * @throws std::runtime_error 文件长度不是 sizeof(T) 的整数倍时抛出。
+         */
+        void open(const char *path, MmapMode mode = MmapMode::ReadWrite)
+        {
+            close();
+            int flags = O_RDONLY;
+            if (mode == MmapMode::ReadWrite)
+                flags = O_RDWR | O_CREAT;
+            else if (mode == MmapMode::Create)
+                flags = O_RDWR | O_CREAT | O_TRUNC;
+            _fd = ::open(path, flags, 0644);
+            if (_fd < 0)
+                ThrowErrno("打开文件失败");
+            _mode = MmapMode::ReadOnly; // 确定大小之前出错时 Release 不能截断文件
+            struct stat st;
+            if (::fstat(_fd, &st) != 0)
+            {
+                int err = errno;
+                Release();
+                throw std::system_error(err, std::generic_category(), "获取文件大小失败");
+            }
+            if (static_cast<size_t>(st.st_size) % sizeof(T) != 0)
+            {
+                // 关闭时会截断到 size()，向下取整会悄悄删掉末尾的字节
+                Release();
+                throw std::runtime_error("MmapVector 文件长度不是元素大小的整数倍！");
+            }
+            _size = _capacity = static_cast<size_t>(st.st_size) / sizeof(T);
+            _mode = mode;
+            if (_capacity != 0)
+            {
+                int prot = read_only() ? PROT_READ : PROT_READ | PROT_WRITE;
+                void *p = ::mmap(nullptr, _capacity * sizeof(T), prot, MAP_SHARED, _fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    int err = errno;
+                    Release();
+                    throw std::system_error(err, std::generic_category(), "映射文件失败");
+                }
+                _start = static_cast<T *>(p);
+            }
+        }
+        /**
+         * @brief 关闭文件，读写模式下先把文件截断到 size()。
+         * 析构函数和移动赋值也会关闭文件，但无法报告错误；需要确认截断成功时应显式调用 close()。
+         * @throws std::system_error 截断文件失败时抛出，此时文件已经关闭。
+         */
+        void close()
+        {
+            int err = Release();
+            if (err != 0)
+                throw std::system_error(err, std::generic_category(), "截断文件失败");
+        }
+        /**
+         * @brief 把修改同步写回磁盘。
+         * @throws std::system_error 同步失败时抛出。
+         */
+        void sync()
+        {
+            if (_start != nullptr && !read_only() && ::msync(_start, _capacity * sizeof(T), MS_SYNC) != 0)
+                ThrowErrno("同步文件失败");
+        }
+        /**
+         * @brief 是否关联了文件。
+         * @return 已打开时返回 true。
+         */
+        bool is_open() const { return _fd >= 0; }
+        /**
+         * @brief 是否为只读映射。
+         * @return 只读时返回 true。
+         */
+        bool read_only() const { return _mode == MmapMode::ReadOnly; }
+
+        // 容量操作
+        /**
+         * @brief 返回当前元素数量。
+         * @return 当前元素数量。
+         */
+        size_t size() const { return _size; }
+        /**
+         * @brief 返回当前容量。
+         * @return 当前容量。
+         */
+        size_t capacity() const { return _capacity; }
+        /**
+         * @brief 检查是否为空。
+         * @return 如果为空则返回 true，否则返回 false。
+         */
+        bool empty() const { return _size == 0; }
+        /**
+         * @brief 预留容量，扩展文件并重新映射。
+         * @param n 预留的容量大小。
+         * @throws std::logic_error 只读或未打开时抛出。
+         * @throws std::system_error 扩展文件或映射失败时抛出。
+         */
+        void reserve(size_t n)
+        {
+            if (n <= _capacity)
+                return;
+            CheckWritable();
+            if (::ftruncate(_fd, n * sizeof(T)) != 0)
+                ThrowErrno("扩展文件失败");
+            void *p;
+            if (_start == nullptr)
+                p = ::mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            else
+                p = Remap(n);
+            if (p == MAP_FAILED)
+                ThrowErrno("映射文件失败");
+            _start = static_cast<T *>(p);
+            _capacity = n;
+        }
+        /**
+         * @brief 调整大小，新增元素为 value。
+         * @param n 新的大小。
+         * @param value 新增元素的值。
+         */
+        void resize(size_t n, const T &value = T())
+        {
+            CheckWritable();
+            reserve(n);
+            for (size_t i = _size; i < n; i++)
+                _start[i] = value;
+            _size = n;
+        }
+        /**
+         * @brief 清空元素，保留容量。
+         */
+        void clear()
+        {
+            CheckWritable();
+            _size = 0;
+        }
+
+        // 获取数据
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         * @throws std::logic_error 只读映射时抛出。
+         */
+        T &operator[](size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < _size, "越界访问！");
+            CheckMutableAccess();
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         */
+        const T &operator[](size_t pos) const
+        {
+            XUSTL_DEBUG_CHECK(pos < _size, "越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         * @throws std::out_of_range 如果 pos 越界。
+         */
+        const T &at(size_t pos) const
+        {
+            if (pos >= _size)
+                throw std::out_of_range("越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回第一个元素，定义 XUSTL_DEBUG 时检查是否为空。
+         * @return 第一个元素的 const 引用。
+         */
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(_size != 0, "MmapVector 为空！");
+            return _start[0];
+        }
+        /**
+         * @brief 返回最后一个元素，定义 XUSTL_DEBUG 时检查是否为空。
+         * @return 最后一个元素的 const 引用。
+         */
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(_size != 0, "MmapVector 为空！");
+            return _start[_size - 1];
+        }
+        /**
+         * @brief 返回映射区首地址，只读映射时抛出异常。
+         * @return 映射区指针，未映射时为 nullptr。
+         * @throws std::logic_error 只读映射时抛出。
+         */
+        T *data()
+        {
+            CheckMutableAccess();
+            return _start;
+        }
+        /**
+         * @brief 返回映射区首地址。
+         * @return 映射区 const 指针，未映射时为 nullptr。
+         */
+        const T *data() const { return _start; }
+
+        // 修改
+        /**
+         * @brief 在末尾添加新元素。
+         * @param value 要添加的元素。
+         */
+        void push_back(const T &value)
+        {
+            if (_size == _capacity)
+            {
+                T tmp = value; // value 可能位于映射区内，重新映射前先拷贝
+                reserve(Growth::next(_capacity, _size + 1, sizeof(T)));
+                _start[_size++] = tmp;
+                return;
+            }
+            CheckWritable();
+            _start[_size++] = value;
+        }
+        /**
+         * @brief 在末尾追加迭代器范围内的元素，最多扩容一次。
+         * @tparam T_iterator 迭代器类型，至少为前向迭代器。
+         * @param first 范围开始迭代器。
+         * @param last 范围结束迭代器。
+         */
+        template <class T_iterator>
+        void append(T_iterator first, T_iterator last)
+        {
+            size_t k = std::distance(first, last);
+            CheckWritable();
+            if (_size + k > _capacity)
+                reserve(Growth::next(_capacity, _size + k, sizeof(T)));
+            for (; first != last; ++first)
+                _start[_size++] = *first;
+        }
+        /**
+         * @brief 移除末尾元素，定义 XUSTL_DEBUG 时检查是否为空。
+         */
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(_size != 0, "MmapVector 为空！");
+            CheckWritable();
+            --_size;
+        }
+        /**
+         * @brief 交换两个 MmapVector 关联的文件。
+         * @param other 另一个 MmapVector。
+         */
+        void swap(MmapVector &other) noexcept
+        {
+            std::swap(_start, other._start);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+            std::swap(_fd, other._fd);
+            std::swap(_mode, other._mode);
+        }
+
+    private:
+        /// @brief 抛出带 errno 的系统异常
+        [[noreturn]] static void ThrowErrno(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+        /// @brief 只读或未打开时抛出异常
+        void CheckWritable() const
+        {
+            if (_fd < 0 || read_only())
+                throw std::logic_error("MmapVector 未打开或为只读！");
+        }
+        /// @brief 只读映射不能交出可写的引用或指针，写入 PROT_READ 映射会触发段错误
+        void CheckMutableAccess() const
+        {
+            if (is_open() && read_only())
+                throw std::logic_error("MmapVector 为只读映射！");
+        }
+        /// @brief 解除映射并关闭文件，读写模式下先截断到 size()
+        /// @return 截断失败时的 errno，成功返回 0
+        int Release() noexcept
+        {
+            int err = 0;
+            if (_start != nullptr)
+                ::munmap(_start, _capacity * sizeof(T));
+            if (_fd >= 0)
+            {
+                if (!read_only() && ::ftruncate(_fd, _size * sizeof(T)) != 0)
+                    err = errno;
+                ::close(_fd);
+            }
+            _start = nullptr;
+            _size = _capacity = 0;
+            _fd = -1;
+            return err;
+        }
+        /// @brief 把映射扩展到 n 个元素，Linux 上由 mremap 移动页表，其他平台重新映射
+        void *Remap(size_t n)
+        {
+#ifdef __linux__
+            return ::mremap(_start, _capacity * sizeof(T), n * sizeof(T), MREMAP_MAYMOVE);
+#else
+            void *p = ::mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            if (p != MAP_FAILED)
+                ::munmap(_start, _capacity * sizeof(T));
+            return p;
+#endif
+        }
+
+    private:
+        T *_start;        ///< 映射区首地址
+        size_t _size;     ///< 元素个数
+        size_t _capacity; ///< 映射的元素个数
+        int _fd;          ///< 文件描述符
+        MmapMode _mode;   ///< 打开方式
+    };
+}
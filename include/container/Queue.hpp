@@ -2,8 +2,10 @@
 /// @brief 队列
 #pragma once
 #include "List.hpp"
+#include "../utility/Debug.hpp"
 #include <iostream>
 #include <initializer_list>
+#include <utility>
 
 namespace XuSTL
 {
@@ -11,22 +13,34 @@ namespace XuSTL
     class Queue
     {
     public:
+        using allocator_type = typename Con::allocator_type; ///< 底层容器的分配器类型
         Queue() {}
+        /// @brief 使用指定分配器构造底层容器
+        /// @param alloc 分配器
+        explicit Queue(const allocator_type &alloc) : _queue(alloc) {}
+        /// @brief 接管一个已配置好的底层容器，如 Overwrite 模式的 RingBuffer
+        /// @param con 底层容器
+        explicit Queue(Con &&con) : _queue(std::move(con)) {}
         void push(const T &value)
         {
             _queue.push_back(value);
         }
+        void push(T &&value)
+        {
+            _queue.push_back(std::move(value));
+        }
         void pop()
         {
-            _queue.erase(_queue.begin());
+            XUSTL_DEBUG_CHECK(!empty(), "队列为空！");
+            _queue.pop_front();
         }
         T &front()
         {
-            return _queue[0];
+            return _queue.front();
         }
         const T &front() const
         {
-            return _queue[0];
+            return _queue.front();
         }
         size_t size() const
         {
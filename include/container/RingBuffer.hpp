@@ -0,0 +1,511 @@
+/// @file RingBuffer.hpp
+/// @brief 容量为 2 的幂的环形缓冲区
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/Relocate.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 满时的行为
+    enum class RingMode
+    {
+        Grow,     ///< 容量翻倍
+        Overwrite ///< 容量固定，push_back 覆盖最旧的元素，push_front 覆盖最新的元素
+    };
+
+    template <class T, class Alloc>
+    class RingBuffer;
+    /// @brief 环形缓冲区迭代器，保存逻辑位置，解引用时才与掩码相与
+    /// @tparam T 数据类型
+    /// @tparam Ref 数据引用
+    /// @tparam Ptr 数据指针
+    template <class T, class Ref = T &, class Ptr = T *>
+    class RingBufferIterator
+    {
+        template <class, class>
+        friend class RingBuffer;                        ///< 允许 RingBuffer 访问私有成员
+        using Self = RingBufferIterator<T, Ref, Ptr>; ///< 自身类型
+
+    public:
+        using iterator_category = std::random_access_iterator_tag; ///< 迭代器类别
+        using value_type = T;                                       ///< 数据类型
+        using difference_type = std::ptrdiff_t;                     ///< 距离类型
+        using pointer = Ptr;                                        ///< 数据指针
+        using reference = Ref;                                      ///< 数据引用
+
+        /// @brief 构造函数
+        /// @param buf 缓冲区
+        /// @param mask 容量减一
+        /// @param pos 逻辑位置
+        RingBufferIterator(T *buf = nullptr, size_t mask = 0, size_t pos = 0) : _buf(buf), _mask(mask), _pos(pos) {}
+        /**
+         * @brief 解引用操作符，返回当前元素
+         * @return 当前元素的引用
+         */
+        Ref operator*() const
+        {
+            XUSTL_DEBUG_CHECK(_buf != nullptr, "解引用无效的迭代器！");
+            return _buf[_pos & _mask];
+        }
+        /**
+         * @brief 箭头操作符，返回当前元素的指针
+         * @return 当前元素的指针
+         */
+        Ptr operator->() const { return &**this; }
+        Ref operator[](difference_type n) const { return *(*this + n); }
+        Self &operator++()
+        {
+            ++_pos;
+            return *this;
+        }
+        Self operator++(int)
+        {
+            Self tmp = *this;
+            ++_pos;
+            return tmp;
+        }
+        Self &operator--()
+        {
+            --_pos;
+            return *this;
+        }
+        Self operator--(int)
+        {
+            Self tmp = *this;
+            --_pos;
+            return tmp;
+        }
+        Self &operator+=(difference_type n)
+        {
+            _pos += n;
+            return *this;
+        }
+        Self &operator-=(difference_type n)
+        {
+            _pos -= n;
+            return *this;
+        }
+        Self operator+(difference_type n) const { return Self(_buf, _mask, _pos + n); }
+        Self operator-(difference_type n) const { return Self(_buf, _mask, _pos - n); }
+        difference_type operator-(const Self &other) const { return static_cast<difference_type>(_pos - other._pos); }
+        bool operator==(const Self &other) const { return _buf == other._buf && _pos == other._pos; }
+        bool operator!=(const Self &other) const { return !(*this == other); }
+        bool operator<(const Self &other) const { return *this - other < 0; }
+        bool operator>(const Self &other) const { return other < *this; }
+        bool operator<=(const Self &other) const { return !(other < *this); }
+        bool operator>=(const Self &other) const { return !(*this < other); }
+
+    private:
+        T *_buf;     ///< 缓冲区
+        size_t _mask; ///< 容量减一
+        size_t _pos;  ///< 逻辑位置，可以越过容量，回绕由掩码处理
+    };
+
+    /// @brief 环形缓冲区，可作为 Queue 的底层容器
+    /// @details 元素连续存放在容量为 2 的幂的缓冲区中，下标与掩码相与得到槽位，头尾增删均为 O(1) 且不逐个分配内存。
+    ///          Grow 模式下满时容量翻倍（均摊 O(1)）；Overwrite 模式下容量固定，满时覆盖另一端的元素。
+    ///          扩容会使全部迭代器失效。
+    /// @tparam T 数据类型
+    /// @tparam Alloc 分配器
+    template <class T, class Alloc = std::allocator<T>>
+    class RingBuffer
+    {
+        using alloc_traits = std::allocator_traits<Alloc>; ///< 分配器萃取
+
+        static const size_t MinCapacity = 16; ///< Grow 模式下第一次分配的容量
+
+    public:
+        using allocator_type = Alloc;                                                        ///< 分配器类型
+        using iterator = RingBufferIterator<T>;                                              ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator, const T &, const T *>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator, T &, T *>;                        ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator, const T &, const T *>; ///< const 反向迭代器
+        // 迭代器相关
+        iterator begin() { return iterator(_buf, Mask(), _head); }
+        iterator end() { return iterator(_buf, Mask(), _tail); }
+        const_iterator begin() const { return const_iterator(iterator(_buf, Mask(), _head)); }
+        const_iterator end() const { return const_iterator(iterator(_buf, Mask(), _tail)); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(iterator(_buf, Mask(), _tail)); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(iterator(_buf, Mask(), _head)); }
+
+        // 构造函数和析构函数
+        RingBuffer() : _buf(nullptr), _cap(0), _head(0), _tail(0), _mode(RingMode::Grow) {}
+        /**
+         * @brief 使用指定分配器构造空缓冲区
+         * @param alloc 分配器
+         */
+        explicit RingBuffer(const Alloc &alloc) : _buf(nullptr), _cap(0), _head(0), _tail(0), _mode(RingMode::Grow), _alloc(alloc) {}
+        /**
+         * @brief 预先分配容量
+         * @param capacity 容量，向上取整到 2 的幂；Overwrite 模式下即固定容量，至少为 1
+         * @param mode 满时的行为
+         * @param alloc 分配器
+         */
+        explicit RingBuffer(size_t capacity, RingMode mode = RingMode::Grow, const Alloc &alloc = Alloc())
+            : _buf(nullptr), _cap(0), _head(0), _tail(0), _mode(mode), _alloc(alloc)
+        {
+            if (capacity > 0 || mode == RingMode::Overwrite)
+                Reallocate(RoundUp(capacity));
+        }
+        /**
+         * @brief 初始化列表构造函数
+         * @param list 初始化列表
+         * @param alloc 分配器
+         */
+        RingBuffer(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : RingBuffer(alloc)
+        {
+            reserve(list.size());
+            for (const T &value : list)
+                push_back(value);
+        }
+        /**
+         * @brief 拷贝构造函数，保留模式和容量
+         * @param other 另一个缓冲区
+         */
+        RingBuffer(const RingBuffer &other)
+            : RingBuffer(alloc_traits::select_on_container_copy_construction(other._alloc))
+        {
+            _mode = other._mode;
+            if (other._cap > 0)
+                Reallocate(other._cap);
+            for (size_t i = other._head; i != other._tail; ++i) // 委托构造已完成，异常时析构函数会清理
+            {
+                alloc_traits::construct(_alloc, _buf + (_tail & Mask()), other._buf[i & other.Mask()]);
+                ++_tail;
+            }
+        }
+        /**
+         * @brief 移动构造函数
+         * @param other 另一个缓冲区，之后为空
+         */
+        RingBuffer(RingBuffer &&other) noexcept
+            : _buf(other._buf), _cap(other._cap), _head(other._head), _tail(other._tail), _mode(other._mode), _alloc(std::move(other._alloc))
+        {
+            other._buf = nullptr;
+            other._cap = other._head = other._tail = 0;
+        }
+        /**
+         * @brief 析构函数
+         */
+        ~RingBuffer()
+        {
+            clear();
+            Deallocate();
+        }
+
+        // 重载
+        RingBuffer &operator=(const RingBuffer &other)
+        {
+            if (this != &other)
+            {
+                RingBuffer tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+        RingBuffer &operator=(RingBuffer &&other) noexcept
+        {
+            RingBuffer tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+        bool operator==(const RingBuffer &other) const
+        {
+            if (size() != other.size())
+                return false;
+            for (size_t i = 0; i < size(); i++)
+                if (!((*this)[i] == other[i]))
+                    return false;
+            return true;
+        }
+        bool operator!=(const RingBuffer &other) const { return !(*this == other); }
+        /**
+         * @brief 返回从队头数起第 pos 个元素，定义 XUSTL_DEBUG 时检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         */
+        T &operator[](size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _buf[(_head + pos) & Mask()];
+        }
+        const T &operator[](size_t pos) const
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _buf[(_head + pos) & Mask()];
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界
+         * @param pos 元素位置
+         * @return 指定位置的元素
+         * @throws std::out_of_range 如果 pos 越界
+         */
+        T &at(size_t pos)
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return (*this)[pos];
+        }
+        const T &at(size_t pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return (*this)[pos];
+        }
+
+        // 容量相关
+        /**
+         * @brief 获取元素个数
+         * @return 元素个数
+         */
+        size_t size() const { return _tail - _head; }
+        /**
+         * @brief 获取容量
+         * @return 容量，总是 0 或 2 的幂
+         */
+        size_t capacity() const { return _cap; }
+        /**
+         * @brief 检查是否为空
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return _tail == _head; }
+        /**
+         * @brief 检查是否已满，再插入将扩容或覆盖
+         * @return 已满返回 true，否则返回 false
+         */
+        bool full() const { return size() == _cap; }
+        /**
+         * @brief 获取满时的行为
+         * @return 模式
+         */
+        RingMode mode() const { return _mode; }
+        /**
+         * @brief 预留容量，Overwrite 模式下也可以用它改变固定容量（只增不减）
+         * @param n 容量，向上取整到 2 的幂
+         */
+        void reserve(size_t n)
+        {
+            if (n > _cap)
+                Reallocate(RoundUp(n));
+        }
+        /**
+         * @brief 清空元素，保留容量
+         */
+        void clear()
+        {
+            DestroyAll(std::is_trivially_destructible<T>());
+            _head = _tail = 0;
+        }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return _alloc; }
+
+        // 获取数据
+        /**
+         * @brief 获取队头元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 队头元素的引用
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            return _buf[_head & Mask()];
+        }
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            return _buf[_head & Mask()];
+        }
+        /**
+         * @brief 获取队尾元素，定义 XUSTL_DEBUG 时检查是否为空
+         * @return 队尾元素的引用
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            return _buf[(_tail - 1) & Mask()];
+        }
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            return _buf[(_tail - 1) & Mask()];
+        }
+
+        // 修改
+        /// @brief 尾插
+        /// @param value 数据
+        void push_back(const T &value) { emplace_back(value); }
+        /// @brief 尾插（移动）
+        /// @param value 数据的右值
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        /// @brief 在尾部原地构造，满时按模式扩容或覆盖队头
+        /// @param args 构造参数
+        /// @return 新元素的引用
+        template <class... Args>
+        T &emplace_back(Args &&...args)
+        {
+            T *slot;
+            if (full())
+            {
+                // 扩容会释放旧内存、覆盖会析构旧元素，args 可能引用它们，先构造出临时对象
+                T tmp(std::forward<Args>(args)...);
+                MakeRoom(true);
+                slot = _buf + (_tail & Mask());
+                alloc_traits::construct(_alloc, slot, std::move(tmp));
+            }
+            else
+            {
+                slot = _buf + (_tail & Mask());
+                alloc_traits::construct(_alloc, slot, std::forward<Args>(args)...);
+            }
+            ++_tail;
+            return *slot;
+        }
+        /// @brief 头插
+        /// @param value 数据
+        void push_front(const T &value) { emplace_front(value); }
+        /// @brief 头插（移动）
+        /// @param value 数据的右值
+        void push_front(T &&value) { emplace_front(std::move(value)); }
+        /// @brief 在头部原地构造，满时按模式扩容或覆盖队尾
+        /// @param args 构造参数
+        /// @return 新元素的引用
+        template <class... Args>
+        T &emplace_front(Args &&...args)
+        {
+            T *slot;
+            if (full())
+            {
+                // 扩容会释放旧内存、覆盖会析构旧元素，args 可能引用它们，先构造出临时对象
+                T tmp(std::forward<Args>(args)...);
+                MakeRoom(false);
+                slot = _buf + ((_head - 1) & Mask());
+                alloc_traits::construct(_alloc, slot, std::move(tmp));
+            }
+            else
+            {
+                slot = _buf + ((_head - 1) & Mask());
+                alloc_traits::construct(_alloc, slot, std::forward<Args>(args)...);
+            }
+            --_head;
+            return *slot;
+        }
+        /// @brief 头删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            alloc_traits::destroy(_alloc, _buf + (_head & Mask()));
+            ++_head;
+        }
+        /// @brief 尾删，定义 XUSTL_DEBUG 时检查是否为空
+        void pop_back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "缓冲区为空！");
+            --_tail;
+            alloc_traits::destroy(_alloc, _buf + (_tail & Mask()));
+        }
+        /// @brief 交换两个缓冲区
+        /// @param other 另一个缓冲区
+        void swap(RingBuffer &other) noexcept
+        {
+            std::swap(_buf, other._buf);
+            std::swap(_cap, other._cap);
+            std::swap(_head, other._head);
+            std::swap(_tail, other._tail);
+            std::swap(_mode, other._mode);
+            std::swap(_alloc, other._alloc);
+        }
+
+    private:
+        /// @brief 下标掩码
+        size_t Mask() const { return _cap - 1; }
+        /// @brief 向上取整到 2 的幂，至少为 1
+        static size_t RoundUp(size_t n)
+        {
+            size_t cap = 1;
+            while (cap < n)
+                cap <<= 1;
+            return cap;
+        }
+        /// @brief 满时腾出一个位置
+        /// @param back 为 true 时将在尾部插入
+        void MakeRoom(bool back)
+        {
+            if (_mode == RingMode::Grow || _cap == 0)
+                Reallocate(_cap == 0 ? MinCapacity : _cap * 2);
+            else if (back)
+                pop_front();
+            else
+                pop_back();
+        }
+        /// @brief 换到容量为 cap 的新缓冲区，元素按顺序搬到开头
+        void Reallocate(size_t cap)
+        {
+            T *buf = alloc_traits::allocate(_alloc, cap);
+            size_t n = size();
+            if (n > 0)
+                RelocateTo(buf, IsTriviallyRelocatable<T>());
+            Deallocate();
+            _buf = buf;
+            _cap = cap;
+            _head = 0;
+            _tail = n;
+        }
+        /// @brief 可平凡重定位：最多两段 memcpy
+        void RelocateTo(T *buf, std::true_type)
+        {
+            size_t first = _head & Mask();
+            size_t n = size();
+            size_t part = n < _cap - first ? n : _cap - first;
+            std::memcpy(static_cast<void *>(buf), static_cast<const void *>(_buf + first), part * sizeof(T));
+            std::memcpy(static_cast<void *>(buf + part), static_cast<const void *>(_buf), (n - part) * sizeof(T));
+        }
+        /// @brief 一般类型：逐个移动构造后析构旧对象
+        void RelocateTo(T *buf, std::false_type)
+        {
+            for (size_t i = _head; i != _tail; ++i, ++buf)
+            {
+                T *old = _buf + (i & Mask());
+                alloc_traits::construct(_alloc, buf, std::move_if_noexcept(*old));
+                alloc_traits::destroy(_alloc, old);
+            }
+        }
+        /// @brief 平凡析构类型无需逐个析构
+        void DestroyAll(std::true_type) {}
+        /// @brief 逐个析构元素
+        void DestroyAll(std::false_type)
+        {
+            for (size_t i = _head; i != _tail; ++i)
+                alloc_traits::destroy(_alloc, _buf + (i & Mask()));
+        }
+        /// @brief 归还缓冲区，元素须已析构或搬走
+        void Deallocate()
+        {
+            if (_buf != nullptr)
+                alloc_traits::deallocate(_alloc, _buf, _cap);
+            _buf = nullptr;
+        }
+
+    private:
+        T *_buf;        ///< 缓冲区
+        size_t _cap;    ///< 容量，0 或 2 的幂
+        size_t _head;   ///< 队头的逻辑位置，只增不减地计数，与掩码相与得到槽位
+        size_t _tail;   ///< 队尾之后的逻辑位置
+        RingMode _mode; ///< 满时的行为
+        Alloc _alloc;   ///< 分配器
+    };
+}
@@ -0,0 +1,188 @@
+/// @file SPSCQueue.hpp
+/// @brief 单生产者单消费者无锁队列
+#pragma once
+#include "../utility/CacheLine.hpp"
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 单生产者单消费者有界无锁队列
+    /// @details 固定容量的环形缓冲区，容量向上取整到 2 的幂。
+    ///          生产者只写 _tail，消费者只写 _head，二者各占一个缓存行，用 acquire/release 同步，
+    ///          两端操作都是无等待的。各端还缓存对端索引，只有看起来满或空时才重新读取对端的缓存行。
+    ///          同一时刻只能有一个线程调用 try_push 系列，一个线程调用 try_pop 系列。
+    /// @tparam T 数据类型
+    /// @tparam Alloc 分配器
+    template <class T, class Alloc = std::allocator<T>>
+    class alignas(CacheLineSize) SPSCQueue
+    {
+        using alloc_traits = std::allocator_traits<Alloc>; ///< 分配器萃取
+
+    public:
+        using value_type = T;         ///< 数据类型
+        using allocator_type = Alloc; ///< 分配器类型
+
+        /**
+         * @brief 构造函数
+         * @param capacity 容量，向上取整到 2 的幂
+         * @param alloc 分配器
+         */
+        explicit SPSCQueue(size_t capacity, const Alloc &alloc = Alloc())
+            : _cap(RoundUp(capacity)), _alloc(alloc), _head(0), _cached_tail(0), _tail(0), _cached_head(0)
+        {
+            _buf = alloc_traits::allocate(_alloc, _cap);
+        }
+        SPSCQueue(const SPSCQueue &) = delete;
+        SPSCQueue &operator=(const SPSCQueue &) = delete;
+        /**
+         * @brief 析构函数，析构剩余元素，此时不能再有线程访问队列
+         */
+        ~SPSCQueue()
+        {
+            for (size_t i = _head.load(std::memory_order_relaxed), e = _tail.load(std::memory_order_relaxed); i != e; ++i)
+                alloc_traits::destroy(_alloc, _buf + (i & (_cap - 1)));
+            alloc_traits::deallocate(_alloc, _buf, _cap);
+        }
+
+        // 生产者
+        /// @brief 尝试入队，队列满时立即返回
+        /// @param value 数据
+        /// @return 成功返回 true，队列满返回 false
+        bool try_push(const T &value) { return try_emplace(value); }
+        /// @brief 尝试入队（移动），队列满时立即返回，value 不被移走
+        /// @param value 数据的右值
+        /// @return 成功返回 true，队列满返回 false
+        bool try_push(T &&value) { return try_emplace(std::move(value)); }
+        /// @brief 尝试在队尾原地构造
+        /// @param args 构造参数
+        /// @return 成功返回 true，队列满返回 false
+        template <class... Args>
+        bool try_emplace(Args &&...args)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head == _cap)
+            {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if (tail - _cached_head == _cap)
+                    return false;
+            }
+            alloc_traits::construct(_alloc, _buf + (tail & (_cap - 1)), std::forward<Args>(args)...);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+        /// @brief 尝试批量入队，能放下多少放多少，整批只发布一次
+        /// @tparam InputIt 输入迭代器类型
+        /// @param first 第一个元素
+        /// @param n 元素个数
+        /// @return 实际入队的个数，first 之后的前这么多个元素已被读取
+        template <class InputIt>
+        size_t try_push_n(InputIt first, size_t n)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (_cap - (tail - _cached_head) < n)
+                _cached_head = _head.load(std::memory_order_acquire);
+            size_t room = _cap - (tail - _cached_head);
+            size_t k = n < room ? n : room;
+            size_t i = 0;
+            try
+            {
+                for (; i < k; ++i, ++first)
+                    alloc_traits::construct(_alloc, _buf + ((tail + i) & (_cap - 1)), *first);
+            }
+            catch (...)
+            {
+                _tail.store(tail + i, std::memory_order_release); // 已构造的元素照常交给消费者
+                throw;
+            }
+            _tail.store(tail + k, std::memory_order_release);
+            return k;
+        }
+
+        // 消费者
+        /// @brief 尝试出队，队列空时立即返回
+        /// @param out 接收出队元素
+        /// @return 成功返回 true，队列空返回 false
+        bool try_pop(T &out)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cached_tail)
+            {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if (head == _cached_tail)
+                    return false;
+            }
+            T *slot = _buf + (head & (_cap - 1));
+            out = std::move(*slot);
+            alloc_traits::destroy(_alloc, slot);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+        /// @brief 尝试批量出队，整批只发布一次
+        /// @tparam OutputIt 输出迭代器类型
+        /// @param out 输出位置，元素移动赋值过去
+        /// @param max 最多出队个数
+        /// @return 实际出队的个数
+        template <class OutputIt>
+        size_t try_pop_n(OutputIt out, size_t max)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (_cached_tail - head < max)
+                _cached_tail = _tail.load(std::memory_order_acquire);
+            size_t avail = _cached_tail - head;
+            size_t k = max < avail ? max : avail;
+            for (size_t i = 0; i < k; ++i, ++out)
+            {
+                T *slot = _buf + ((head + i) & (_cap - 1));
+                *out = std::move(*slot);
+                alloc_traits::destroy(_alloc, slot);
+            }
+            _head.store(head + k, std::memory_order_release);
+            return k;
+        }
+
+        // 容量相关
+        /**
+         * @brief 获取元素个数，并发时只是近似值
+         * @return 元素个数
+         */
+        size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+        /**
+         * @brief 检查是否为空，并发时只是近似值
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return size() == 0; }
+        /**
+         * @brief 获取容量
+         * @return 容量，2 的幂
+         */
+        size_t capacity() const { return _cap; }
+        /**
+         * @brief 获取分配器
+         * @return 分配器的副本
+         */
+        Alloc get_allocator() const { return _alloc; }
+
+    private:
+        /// @brief 向上取整到 2 的幂，至少为 2
+        static size_t RoundUp(size_t n)
+        {
+            size_t cap = 2;
+            while (cap < n)
+                cap <<= 1;
+            return cap;
+        }
+
+    private:
+        T *_buf;                                          ///< 缓冲区，构造后只读
+        size_t _cap;                                      ///< 容量，构造后只读
+        Alloc _alloc;                                     ///< 分配器
+        alignas(CacheLineSize) std::atomic<size_t> _head; ///< 下一个出队位置，只有消费者写
+        size_t _cached_tail;                              ///< 消费者缓存的 _tail
+        alignas(CacheLineSize) std::atomic<size_t> _tail; ///< 下一个入队位置，只有生产者写
+        size_t _cached_head;                              ///< 生产者缓存的 _head
+    };
+}
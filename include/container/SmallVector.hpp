@@ -0,0 +1,531 @@
+/// @file SmallVector.hpp
+/// @brief 带内联缓冲区的动态数组
+#pragma once
+#include "../adapter/ReverseIterator.hpp"
+#include "../adapter/ConstIterator.hpp"
+#include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/Relocate.hpp"
+#include "../utility/Debug.hpp"
+#include <iostream>
+#include <initializer_list>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+namespace XuSTL
+{
+    /**
+     * @brief 小容量优化的动态数组，接口与 Vector 一致。
+     *
+     * 前 N 个元素存放在对象内部的缓冲区中，不分配堆内存；
+     * 超过 N 个元素时才转移到堆上，之后按 2 倍扩容。
+     *
+     * @tparam T 元素类型
+     * @tparam N 内联缓冲区可容纳的元素个数
+     * @tparam Alloc 堆内存分配器类型，默认为 std::allocator<T>
+     */
+    template <class T, size_t N, class Alloc = std::allocator<T>>
+    class SmallVector
+    {
+        static_assert(N > 0, "内联容量必须大于 0");
+        using alloc_traits = std::allocator_traits<Alloc>; ///< 分配器萃取
+
+    public:
+        using allocator_type = Alloc;                                  ///< 分配器类型
+        using iterator = T *;                                          ///< 普通迭代器
+        using const_iterator = ConstIterator<iterator>;                ///< const 迭代器
+        using reverse_iterator = ReverseIterator<iterator>;            ///< 反向迭代器
+        using const_reverse_iterator = ConstReverseIterator<iterator>; ///< const 反向迭代器
+        // 迭代器相关
+        /**
+         * @brief 返回指向第一个元素的迭代器。
+         * @return 指向第一个元素的迭代器。
+         */
+        iterator begin() { return _start; }
+        /**
+         * @brief 返回指向最后一个元素之后的迭代器。
+         * @return 指向最后一个元素之后的迭代器。
+         */
+        iterator end() { return _finish; }
+        /**
+         * @brief 返回指向第一个元素的 const 迭代器。
+         * @return 指向第一个元素的 const 迭代器。
+         */
+        const_iterator begin() const { return const_iterator(_start); }
+        /**
+         * @brief 返回指向最后一个元素之后的 const 迭代器。
+         * @return 指向最后一个元素之后的 const 迭代器。
+         */
+        const_iterator end() const { return const_iterator(_finish); }
+        /**
+         * @brief 返回指向最后一个元素的反向迭代器。
+         * @return 指向最后一个元素的反向迭代器。
+         */
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        /**
+         * @brief 返回指向第一个元素之前的反向迭代器。
+         * @return 指向第一个元素之前的反向迭代器。
+         */
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        /**
+         * @brief 返回指向最后一个元素的 const 反向迭代器。
+         * @return 指向最后一个元素的 const 反向迭代器。
+         */
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(_finish); }
+        /**
+         * @brief 返回指向第一个元素之前的 const 反向迭代器。
+         * @return 指向第一个元素之前的 const 反向迭代器。
+         */
+        const_reverse_iterator crend() const { return const_reverse_iterator(_start); }
+
+        // 构造函数和析构函数
+        /**
+         * @brief 默认构造函数，使用内联缓冲区，不分配内存。
+         */
+        SmallVector() : _start(Inline()), _finish(Inline()), _end_of_storage(Inline() + N) {}
+        /**
+         * @brief 使用指定分配器构造空 SmallVector，不分配内存。
+         * @param alloc 堆内存分配器。
+         */
+        explicit SmallVector(const Alloc &alloc) : _start(Inline()), _finish(Inline()), _end_of_storage(Inline() + N), _alloc(alloc) {}
+        /**
+         * @brief 用指定数量和默认值构造 SmallVector。
+         * @param n 元素数量。
+         * @param value 默认值，默认为 T 的默认构造函数。
+         * @param alloc 堆内存分配器。
+         */
+        SmallVector(size_t n, const T &value = T(), const Alloc &alloc = Alloc()) : SmallVector(alloc)
+        {
+            reserve(n);
+            for (; _finish != _start + n; ++_finish)
+                Construct(_finish, value);
+        }
+        /**
+         * @brief 用迭代器范围构造 SmallVector。
+         * @tparam T_iterator 迭代器类型。
+         * @param first 范围开始迭代器。
+         * @param second 范围结束迭代器。
+         * @param alloc 堆内存分配器。
+         */
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        SmallVector(T_iterator first, T_iterator second, const Alloc &alloc = Alloc()) : SmallVector(alloc)
+        {
+            reserve(std::distance(first, second));
+            for (; first != second; ++first, ++_finish)
+                Construct(_finish, *first);
+        }
+        /**
+         * @brief 拷贝构造函数。
+         * @param other 另一个 SmallVector。
+         */
+        SmallVector(const SmallVector &other)
+            : SmallVector(other._start, other._finish, alloc_traits::select_on_container_copy_construction(other._alloc)) {}
+        /**
+         * @brief 移动构造函数，连同分配器一起移动；other 在堆上时直接接管内存，否则逐个移动内联元素。
+         * @param other 另一个 SmallVector，移动后为空。
+         */
+        SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : _start(Inline()), _finish(Inline()), _end_of_storage(Inline() + N), _alloc(std::move(other._alloc))
+        {
+            TakeFrom(other);
+        }
+        /**
+         * @brief 用初始化列表构造 SmallVector。
+         * @param list 初始化列表。
+         * @param alloc 堆内存分配器。
+         */
+        SmallVector(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : SmallVector(list.begin(), list.end(), alloc) {}
+        /**
+         * @brief 析构函数。
+         */
+        ~SmallVector()
+        {
+            Release();
+        }
+
+        // 重载
+        /**
+         * @brief 赋值运算符重载。
+         * @param other 另一个 SmallVector。
+         * @return 当前 SmallVector 的引用。
+         */
+        SmallVector &operator=(const SmallVector &other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.size());
+                for (const T *it = other._start; it != other._finish; ++it, ++_finish)
+                    Construct(_finish, *it);
+            }
+            return *this;
+        }
+        /**
+         * @brief 移动赋值运算符重载，分配器随 other 的内存一起转移。
+         * @param other 另一个 SmallVector。
+         * @return 当前 SmallVector 的引用。
+         */
+        SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &other)
+            {
+                Release();
+                std::swap(_alloc, other._alloc); // 与 Vector 一样分配器随内存转移，other 留下当前的分配器
+                TakeFrom(other);
+            }
+            return *this;
+        }
+        /**
+         * @brief 相等比较运算符重载。
+         * @param other 另一个 SmallVector。
+         * @return 如果相等则返回 true，否则返回 false。
+         */
+        bool operator==(const SmallVector &other) const
+        {
+            return size() == other.size() && std::equal(_start, _finish, other._start);
+        }
+        /**
+         * @brief 不相等比较运算符重载。
+         * @param other 另一个 SmallVector。
+         * @return 如果不相等则返回 true，否则返回 false。
+         */
+        bool operator!=(const SmallVector &other) const { return !((*this) == other); }
+
+        // 容量操作
+        /**
+         * @brief 返回当前元素数量。
+         * @return 当前元素数量。
+         */
+        size_t size() const { return (_finish - _start); }
+        /**
+         * @brief 返回当前容量。
+         * @return 当前容量。
+         */
+        size_t capacity() const { return (_end_of_storage - _start); }
+        /**
+         * @brief 检查元素是否仍存放在内联缓冲区中。
+         * @return 未分配堆内存时返回 true。
+         */
+        bool is_small() const { return _start == Inline(); }
+        /**
+         * @brief 预留容量，超过内联容量时转移到堆上。
+         * @param n 预留的容量大小。
+         */
+        void reserve(size_t n)
+        {
+            if (n <= capacity())
+                return;
+            iterator new_start = alloc_traits::allocate(_alloc, n);
+            size_t sz = size();
+            MoveElements(new_start, IsTriviallyRelocatable<T>());
+            FreeHeap();
+            _start = new_start;
+            _finish = _start + sz;
+            _end_of_storage = _start + n;
+        }
+        /**
+         * @brief 调整大小，增加或减少元素数量。
+         * @param n 新的大小。
+         * @param value 新增元素的默认值，默认为 T 的默认构造函数。
+         */
+        void resize(size_t n, const T &value = T())
+        {
+            if (n < size())
+            {
+                Destroy(_start + n, _finish);
+                _finish = _start + n;
+                return;
+            }
+            reserve(n);
+            for (; _finish != _start + n; ++_finish)
+                Construct(_finish, value);
+        }
+        /**
+         * @brief 清空 SmallVector，析构所有元素，保留容量。
+         */
+        void clear()
+        {
+            Destroy(_start, _finish);
+            _finish = _start;
+        }
+        /**
+         * @brief 检查 SmallVector 是否为空。
+         * @return 如果为空则返回 true，否则返回 false。
+         */
+        bool empty() const { return _start == _finish; }
+        /**
+         * @brief 返回分配器的副本。
+         * @return 分配器。
+         */
+        allocator_type get_allocator() const { return _alloc; }
+
+        // 获取数据
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         */
+        T &operator[](size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         */
+        const T &operator[](size_t pos) const
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         * @throws std::out_of_range 如果 pos 越界。
+         */
+        T &at(size_t pos)
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         * @throws std::out_of_range 如果 pos 越界。
+         */
+        const T &at(size_t pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回第一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 第一个元素的引用。
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "SmallVector 为空！");
+            return *_start;
+        }
+        /**
+         * @brief 返回第一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 第一个元素的 const 引用。
+         */
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "SmallVector 为空！");
+            return *_start;
+        }
+        /**
+         * @brief 返回最后一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 最后一个元素的引用。
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "SmallVector 为空！");
+            return *(_finish - 1);
+        }
+        /**
+         * @brief 返回最后一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 最后一个元素的 const 引用。
+         */
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "SmallVector 为空！");
+            return *(_finish - 1);
+        }
+        /**
+         * @brief 返回底层数组的首地址。
+         * @return 底层数组指针。
+         */
+        T *data() { return _start; }
+        /**
+         * @brief 返回底层数组的首地址。
+         * @return 底层数组 const 指针。
+         */
+        const T *data() const { return _start; }
+
+        // 修改
+        /**
+         * @brief 在末尾添加新元素。
+         * @param value 要添加的元素。
+         */
+        void push_back(const T &value) { emplace_back(value); }
+        /**
+         * @brief 在末尾添加新元素（移动）。
+         * @param value 要添加的元素。
+         */
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        /**
+         * @brief 在末尾原地构造新元素。
+         * @tparam Args 构造参数类型。
+         * @param args 构造参数。
+         * @return 新元素的引用。
+         */
+        template <class... Args>
+        T &emplace_back(Args &&...args)
+        {
+            if (_finish == _end_of_storage)
+            {
+                T tmp(std::forward<Args>(args)...); // args 可能引用本容器内的元素，扩容前先构造
+                reserve(capacity() * 2);
+                Construct(_finish, std::move(tmp));
+            }
+            else
+            {
+                Construct(_finish, std::forward<Args>(args)...);
+            }
+            return *(_finish++);
+        }
+        /**
+         * @brief 移除末尾元素。
+         */
+        void pop_back() { erase(_finish - 1); }
+        /**
+         * @brief 在指定位置插入新元素。
+         * @param pos 插入位置。
+         * @param value 要插入的元素。
+         * @return 新插入元素的位置迭代器。
+         */
+        iterator insert(iterator pos, const T &value) { return emplace(pos, value); }
+        /**
+         * @brief 在指定位置插入新元素（移动）。
+         * @param pos 插入位置。
+         * @param value 要插入的元素。
+         * @return 新插入元素的位置迭代器。
+         */
+        iterator insert(iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+        /**
+         * @brief 在指定位置原地构造新元素。
+         * @tparam Args 构造参数类型。
+         * @param pos 插入位置。
+         * @param args 构造参数。
+         * @return 新插入元素的位置迭代器。
+         */
+        template <class... Args>
+        iterator emplace(iterator pos, Args &&...args)
+        {
+            size_t offset = pos - _start;
+            if (pos == _finish)
+            {
+                emplace_back(std::forward<Args>(args)...);
+                return _start + offset;
+            }
+            T tmp(std::forward<Args>(args)...);
+            if (_finish == _end_of_storage)
+                reserve(capacity() * 2);
+            pos = _start + offset;
+            Construct(_finish, std::move(*(_finish - 1)));
+            std::move_backward(pos, _finish - 1, _finish);
+            *pos = std::move(tmp);
+            _finish++;
+            return pos;
+        }
+        /**
+         * @brief 移除指定位置的元素，定义 XUSTL_DEBUG 时检查越界。
+         * @param pos 要移除的元素位置。
+         * @return 移除后的位置迭代器。
+         */
+        iterator erase(iterator pos)
+        {
+            XUSTL_DEBUG_CHECK(pos >= _start && pos < _finish, "越界移除！");
+            std::move(pos + 1, _finish, pos);
+            _finish--;
+            alloc_traits::destroy(_alloc, _finish);
+            return pos;
+        }
+        /**
+         * @brief 交换当前 SmallVector 和另一个 SmallVector 的内容。
+         * @param other 另一个 SmallVector。
+         */
+        void swap(SmallVector &other)
+        {
+            SmallVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        /// @brief 内联缓冲区首地址
+        iterator Inline() { return reinterpret_cast<iterator>(&_buffer); }
+        /// @brief 内联缓冲区首地址
+        const T *Inline() const { return reinterpret_cast<const T *>(&_buffer); }
+        /// @brief 在未初始化的内存上构造元素
+        /// @param p 目标地址
+        /// @param args 构造参数
+        template <class... Args>
+        void Construct(iterator p, Args &&...args)
+        {
+            alloc_traits::construct(_alloc, p, std::forward<Args>(args)...);
+        }
+        /// @brief 析构 [first, last) 内的元素，不释放内存
+        void Destroy(iterator first, iterator last)
+        {
+            for (; first != last; ++first)
+                alloc_traits::destroy(_alloc, first);
+        }
+        /// @brief 可平凡重定位：整体 memcpy，旧对象不再析构
+        /// @param dst 目标地址
+        void MoveElements(iterator dst, std::true_type)
+        {
+            if (_start != _finish)
+                std::memcpy(static_cast<void *>(dst), static_cast<const void *>(_start), size() * sizeof(T));
+        }
+        /// @brief 一般类型：逐个移动构造后析构旧对象
+        /// @param dst 目标地址
+        void MoveElements(iterator dst, std::false_type)
+        {
+            size_t sz = size();
+            for (size_t i = 0; i < sz; i++)
+                Construct(dst + i, std::move_if_noexcept(_start[i]));
+            Destroy(_start, _finish);
+        }
+        /// @brief 归还堆内存（在内联缓冲区时什么都不做），不析构元素
+        void FreeHeap()
+        {
+            if (!is_small())
+                alloc_traits::deallocate(_alloc, _start, capacity());
+        }
+        /// @brief 析构全部元素并回到内联缓冲区
+        void Release()
+        {
+            Destroy(_start, _finish);
+            FreeHeap();
+            _start = _finish = Inline();
+            _end_of_storage = Inline() + N;
+        }
+        /// @brief 从 other 接管元素，要求当前对象为空且处于内联状态
+        /// @param other 另一个 SmallVector，接管后为空
+        void TakeFrom(SmallVector &other)
+        {
+            if (other.is_small())
+            {
+                for (iterator it = other._start; it != other._finish; ++it, ++_finish)
+                    Construct(_finish, std::move(*it));
+                other.clear();
+                return;
+            }
+            _start = other._start;
+            _finish = other._finish;
+            _end_of_storage = other._end_of_storage;
+            other._start = other._finish = other.Inline();
+            other._end_of_storage = other.Inline() + N;
+        }
+
+    private:
+        iterator _start;                                                       ///< 元素开始迭代器
+        iterator _finish;                                                      ///< 元素结束迭代器
+        iterator _end_of_storage;                                              ///< 内存末尾迭代器
+        Alloc _alloc;                                                          ///< 分配器
+        typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _buffer; ///< 内联缓冲区
+    };
+}
@@ -11,7 +11,11 @@ namespace XuSTL
     class Stack
     {
     public:
+        using allocator_type = typename Con::allocator_type; ///< 底层容器的分配器类型
         Stack() {}
+        /// @brief 使用指定分配器构造底层容器
+        /// @param alloc 分配器
+        explicit Stack(const allocator_type &alloc) : _stack(alloc) {}
         void push(const T &value)
         {
             _stack.push_back(value);
@@ -4,19 +4,41 @@
 #include "../adapter/ReverseIterator.hpp"
 #include "../adapter/ConstIterator.hpp"
 #include "../adapter/ConstReverseIterator.hpp"
+#include "../memory/Relocate.hpp"
+#include "../memory/GrowthPolicy.hpp"
+#include "../utility/Debug.hpp"
+#include "../utility/Serialize.hpp"
 #include <iostream>
+#include <cstring>
 #include <initializer_list>
+#include <memory>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 namespace XuSTL
 {
     /**
      * @brief 自定义 Vector 类，提供动态数组功能。
      *
+     * 底层为未初始化的原始内存，元素只在 [_start, _finish) 内存活，
+     * 预留的容量不会构造任何对象。
+     * 扩容时可平凡重定位的元素整体 memcpy，若分配器还提供 reallocate（如 MallocAllocator），
+     * 则直接原地 realloc。
+     *
      * @tparam T 元素类型
+     * @tparam Alloc 分配器类型，默认为 std::allocator<T>
+     * @tparam Growth 扩容策略，默认为 1.5 倍几何扩容，见 GrowthPolicy.hpp
      */
-    template <class T>
+    template <class T, class Alloc = std::allocator<T>, class Growth = GeometricGrowth<>>
     class Vector
     {
+        using alloc_traits = std::allocator_traits<Alloc>; ///< 分配器萃取
+        /// @brief 是否可以通过分配器 reallocate 扩容
+        static constexpr bool can_realloc = IsTriviallyRelocatable<T>::value && HasReallocate<Alloc>::value;
+
     public:
+        using allocator_type = Alloc;                                  ///< 分配器类型
         using iterator = T *;                                          ///< 普通迭代器
         using const_iterator = ConstIterator<iterator>;                ///< const 迭代器
         using reverse_iterator = ReverseIterator<iterator>;            ///< 反向迭代器
@@ -36,12 +58,12 @@ namespace XuSTL
          * @brief 返回指向第一个元素的 const 迭代器。
          * @return 指向第一个元素的 const 迭代器。
          */
-        const_iterator begin() const { return const_iterator(begin()); }
+        const_iterator begin() const { return const_iterator(_start); }
         /**
          * @brief 返回指向最后一个元素之后的 const 迭代器。
          * @return 指向最后一个元素之后的 const 迭代器。
          */
-        const_iterator end() const { return const_iterator(end()); }
+        const_iterator end() const { return const_iterator(_finish); }
         /**
          * @brief 返回指向最后一个元素的反向迭代器。
          * @return 指向最后一个元素的反向迭代器。
@@ -56,72 +78,89 @@ namespace XuSTL
          * @brief 返回指向最后一个元素的 const 反向迭代器。
          * @return 指向最后一个元素的 const 反向迭代器。
          */
-        const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(_finish); }
         /**
          * @brief 返回指向第一个元素之前的 const 反向迭代器。
          * @return 指向第一个元素之前的 const 反向迭代器。
          */
-        const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(_start); }
 
         // 构造函数和析构函数
         /**
-         * @brief 默认构造函数，初始化容量为10。
+         * @brief 默认构造函数，不分配内存，首次插入时才分配。
+         */
+        Vector() : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr) {}
+        /**
+         * @brief 使用指定分配器构造空 Vector，不分配内存。
+         * @param alloc 分配器。
          */
-        Vector() : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr) { reserve(10); }
+        explicit Vector(const Alloc &alloc) : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr), _alloc(alloc) {}
         /**
          * @brief 用指定数量和默认值构造 Vector。
          * @param n 元素数量。
          * @param value 默认值，默认为 T 的默认构造函数。
+         * @param alloc 分配器。
          */
-        Vector(int n, const T &value = T())
-            : _start(new T[n]), _finish(_start + n), _end_of_storage(_start + n)
+        Vector(int n, const T &value = T(), const Alloc &alloc = Alloc())
+            : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr), _alloc(alloc)
         {
-            for (size_t i = 0; i < n; i++)
-                _start[i] = value;
+            reserve(n);
+            for (; _finish != _start + n; ++_finish)
+                Construct(_finish, value);
         }
         /**
          * @brief 用迭代器范围构造 Vector。
          * @tparam T_iterator 迭代器类型。
          * @param first 范围开始迭代器。
          * @param second 范围结束迭代器。
+         * @param alloc 分配器。
          */
-        template <class T_iterator>
-        Vector(T_iterator first, T_iterator second)
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        Vector(T_iterator first, T_iterator second, const Alloc &alloc = Alloc())
+            : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr), _alloc(alloc)
         {
             size_t n = std::distance(first, second); // 计算范围大小
-            _start = new T[n];
-            _finish = _start + n;
-            _end_of_storage = _start + n;
-            std::copy(first, second, _start);
+            reserve(n);
+            for (; first != second; ++first, ++_finish)
+                Construct(_finish, *first);
         }
         /**
          * @brief 拷贝构造函数。
          * @param other 另一个 Vector。
          */
-        Vector(const Vector<T> &other)
+        Vector(const Vector<T, Alloc, Growth> &other)
+            : _start(nullptr), _finish(nullptr), _end_of_storage(nullptr),
+              _alloc(alloc_traits::select_on_container_copy_construction(other._alloc))
         {
-            swap(other);
+            reserve(other.size());
+            for (const T *it = other._start; it != other._finish; ++it, ++_finish)
+                Construct(_finish, *it);
         }
         /**
-         * @brief 移动构造函数。
-         * @param other 另一个 Vector。
+         * @brief 移动构造函数，直接接管 other 的内存，O(1)。
+         * @param other 另一个 Vector，移动后为空。
          */
-        Vector(Vector<T> &&other) : Vector(other.begin(), other.end()) {}
+        Vector(Vector<T, Alloc, Growth> &&other) noexcept
+            : _start(other._start), _finish(other._finish), _end_of_storage(other._end_of_storage),
+              _alloc(std::move(other._alloc))
+        {
+            other._start = nullptr;
+            other._finish = nullptr;
+            other._end_of_storage = nullptr;
+        }
         /**
          * @brief 用初始化列表构造 Vector。
          * @param list 初始化列表。
+         * @param alloc 分配器。
          */
-        Vector(const std::initializer_list<T> &list) : Vector(list.begin(), list.end()) {}
+        Vector(const std::initializer_list<T> &list, const Alloc &alloc = Alloc()) : Vector(list.begin(), list.end(), alloc) {}
         /**
          * @brief 析构函数。
          */
         ~Vector()
         {
-            if (_start != nullptr)
-                delete[] _start;
-            _start = nullptr;
-            _finish = nullptr;
-            _end_of_storage = nullptr;
+            Release();
         }
 
         // 重载
@@ -130,40 +169,44 @@ namespace XuSTL
          * @param other 另一个 Vector。
          * @return 当前 Vector 的引用。
          */
-        Vector<T> &operator=(Vector<T> other)
+        Vector<T, Alloc, Growth> &operator=(const Vector<T, Alloc, Growth> &other)
         {
-            swap(other);
+            if (this != &other)
+            {
+                Vector<T, Alloc, Growth> tmp(other);
+                swap(tmp);
+            }
             return *this;
         }
         /**
-         * @brief 移动赋值运算符重载。
+         * @brief 移动赋值运算符重载，交换内存后由 other 释放旧数据，O(1)。
          * @param other 另一个 Vector。
          * @return 当前 Vector 的引用。
          */
-        Vector<T> &operator=(Vector<T> &&other)
+        Vector<T, Alloc, Growth> &operator=(Vector<T, Alloc, Growth> &&other) noexcept
         {
-            for (auto &it : other)
-                push_back(it);
+            if (this != &other)
+            {
+                Release();
+                swap(other);
+            }
             return *this;
         }
         /**
-         * @brief 相等比较运算符重载。
+         * @brief 相等比较运算符重载，先比较大小再逐元素比较。
          * @param other 另一个 Vector。
          * @return 如果相等则返回 true，否则返回 false。
          */
-        bool operator==(const Vector<T> &other)
+        bool operator==(const Vector<T, Alloc, Growth> &other) const
         {
-            for (size_t i = 0; i < other.size(); i++)
-                if (this[i] != other[i])
-                    return false;
-            return true;
+            return size() == other.size() && std::equal(_start, _finish, other._start);
         }
         /**
          * @brief 不相等比较运算符重载。
          * @param other 另一个 Vector。
          * @return 如果不相等则返回 true，否则返回 false。
          */
-        bool operator!=(const Vector<T> &other) { return !((*this) == other); }
+        bool operator!=(const Vector<T, Alloc, Growth> &other) const { return !((*this) == other); }
         // 容量操作
         /**
          * @brief 返回当前元素数量。
@@ -176,20 +219,26 @@ namespace XuSTL
          */
         size_t capacity() const { return (_end_of_storage - _start); }
         /**
-         * @brief 预留容量。
+         * @brief 预留容量，只分配内存，不构造元素。
          * @param n 预留的容量大小。
          */
         void reserve(size_t n)
         {
-            size_t sz = size();
-            if (n < capacity())
+            if (n <= capacity())
                 return;
-            iterator new_start = new T[n];
-            std::copy(_start, _finish, new_start);
-            delete[] _start;
-            _start = new_start;
-            _finish = _start + sz;
-            _end_of_storage = _start + n;
+            Reallocate(n, std::integral_constant<bool, can_realloc>());
+        }
+        /**
+         * @brief 释放多余容量，使容量等于元素个数。
+         */
+        void shrink_to_fit()
+        {
+            if (capacity() == size())
+                return;
+            if (empty())
+                Release();
+            else
+                Reallocate(size(), std::integral_constant<bool, can_realloc>());
         }
         /**
          * @brief 调整大小，增加或减少元素数量。
@@ -199,51 +248,177 @@ namespace XuSTL
         void resize(size_t n, const T &value = T())
         {
             size_t sz = size();
-            size_t cp = capacity();
             if (n < sz)
             {
+                Destroy(_start + n, _finish);
                 _finish = _start + n;
                 return;
             }
-            if (n > cp)
+            if (n > capacity())
                 reserve(n);
-            for (size_t i = sz; i < n; i++)
-                _start[i] = value;
-            _finish = _start + n;
+            for (; _finish != _start + n; ++_finish)
+                Construct(_finish, value);
         }
         /**
-         * @brief 清空 Vector，移除所有元素。
+         * @brief 清空 Vector，析构所有元素，保留容量。
          */
-        void clear() { _finish = _start; }
+        void clear()
+        {
+            Destroy(_start, _finish);
+            _finish = _start;
+        }
         /**
          * @brief 检查 Vector 是否为空。
          * @return 如果为空则返回 true，否则返回 false。
          */
         bool empty() const { return _start == _finish; }
+        /**
+         * @brief 返回分配器的副本。
+         * @return 分配器。
+         */
+        allocator_type get_allocator() const { return _alloc; }
 
         // 获取数据
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         */
         T &operator[](size_t pos)
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，不检查越界（定义 XUSTL_DEBUG 时检查）。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         */
+        const T &operator[](size_t pos) const
+        {
+            XUSTL_DEBUG_CHECK(pos < size(), "越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回指定位置的元素，总是检查越界。
+         * @param pos 元素位置。
+         * @return 指定位置的元素。
+         * @throws std::out_of_range 如果 pos 越界。
+         */
+        T &at(size_t pos)
         {
             if (pos >= size())
-            {
                 throw std::out_of_range("越界访问！");
-            }
-            return *(_start + pos);
+            return _start[pos];
         }
         /**
-         * @brief 返回指定位置的元素。
+         * @brief 返回指定位置的元素，总是检查越界。
          * @param pos 元素位置。
          * @return 指定位置的元素。
          * @throws std::out_of_range 如果 pos 越界。
          */
-        const T &operator[](size_t pos) const { return this[pos]; }
+        const T &at(size_t pos) const
+        {
+            if (pos >= size())
+                throw std::out_of_range("越界访问！");
+            return _start[pos];
+        }
+        /**
+         * @brief 返回第一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 第一个元素的引用。
+         */
+        T &front()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "Vector 为空！");
+            return *_start;
+        }
+        /**
+         * @brief 返回第一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 第一个元素的 const 引用。
+         */
+        const T &front() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "Vector 为空！");
+            return *_start;
+        }
+        /**
+         * @brief 返回最后一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 最后一个元素的引用。
+         */
+        T &back()
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "Vector 为空！");
+            return *(_finish - 1);
+        }
+        /**
+         * @brief 返回最后一个元素，不检查是否为空（定义 XUSTL_DEBUG 时检查）。
+         * @return 最后一个元素的 const 引用。
+         */
+        const T &back() const
+        {
+            XUSTL_DEBUG_CHECK(!empty(), "Vector 为空！");
+            return *(_finish - 1);
+        }
+        /**
+         * @brief 返回底层数组的首地址。
+         * @return 底层数组指针，未分配内存时为 nullptr。
+         */
+        T *data() { return _start; }
+        /**
+         * @brief 返回底层数组的首地址。
+         * @return 底层数组 const 指针，未分配内存时为 nullptr。
+         */
+        const T *data() const { return _start; }
 
         // 修改
         /**
          * @brief 在末尾添加新元素。
          * @param value 要添加的元素。
          */
-        void push_back(const T &value) { insert(_finish, value); }
+        void push_back(const T &value) { emplace_back(value); }
+        /**
+         * @brief 在末尾添加新元素（移动）。
+         * @param value 要添加的元素。
+         */
+        void push_back(T &&value) { emplace_back(std::move(value)); }
+        /**
+         * @brief 在末尾原地构造新元素。
+         * @tparam Args 构造参数类型。
+         * @param args 构造参数。
+         * @return 新元素的引用。
+         */
+        template <class... Args>
+        T &emplace_back(Args &&...args)
+        {
+            size_t sz = size();
+            size_t new_cp = NextCapacity(sz + 1);
+            if (new_cp == capacity())
+            {
+                Construct(_finish, std::forward<Args>(args)...);
+                return *(_finish++);
+            }
+            if (can_realloc)
+            {
+                // realloc 会使旧内存失效，先构造出临时对象
+                T tmp(std::forward<Args>(args)...);
+                reserve(new_cp);
+                Construct(_finish, std::move(tmp));
+                return *(_finish++);
+            }
+            // 先在新内存上构造新元素，args 可能引用旧内存中的元素
+            iterator new_start = alloc_traits::allocate(_alloc, new_cp);
+            try
+            {
+                Construct(new_start + sz, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(_alloc, new_start, new_cp);
+                throw;
+            }
+            Relocate(new_start, new_cp);
+            return *(_finish++);
+        }
         /**
          * @brief 移除末尾元素。
          */
@@ -252,11 +427,12 @@ namespace XuSTL
          * @brief 交换当前 Vector 和另一个 Vector 的内容。
          * @param v 另一个 Vector。
          */
-        void swap(Vector<T> &v) noexcept
+        void swap(Vector<T, Alloc, Growth> &v) noexcept
         {
             std::swap(this->_start, v._start);
             std::swap(this->_finish, v._finish);
             std::swap(this->_end_of_storage, v._end_of_storage);
+            std::swap(this->_alloc, v._alloc);
         }
         /**
          * @brief 在指定位置插入新元素。
@@ -264,42 +440,382 @@ namespace XuSTL
          * @param value 要插入的元素。
          * @return 新插入元素的位置迭代器。
          */
-        iterator insert(iterator pos, const T &value)
+        iterator insert(iterator pos, const T &value) { return emplace(pos, value); }
+        /**
+         * @brief 在指定位置插入新元素（移动）。
+         * @param pos 插入位置。
+         * @param value 要插入的元素。
+         * @return 新插入元素的位置迭代器。
+         */
+        iterator insert(iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+        /**
+         * @brief 在指定位置原地构造新元素。
+         * @tparam Args 构造参数类型。
+         * @param pos 插入位置。
+         * @param args 构造参数。
+         * @return 新插入元素的位置迭代器。
+         */
+        template <class... Args>
+        iterator emplace(iterator pos, Args &&...args)
         {
             size_t offset = pos - _start;
-            size_t sz = size();
-            size_t cp = capacity();
-            if ((sz + 1) * 10 >= cp * 8)
-                reserve(cp * 1.5);
+            if (pos == _finish)
+            {
+                emplace_back(std::forward<Args>(args)...);
+                return _start + offset;
+            }
+            T tmp(std::forward<Args>(args)...); // args 可能引用本容器内的元素，扩容前先构造
+            reserve(NextCapacity(size() + 1));
             pos = _start + offset;
-            for (auto it = _finish; it != pos; it--)
-                *it = std::move(*(it - 1));
-            *pos = value;
+            Construct(_finish, std::move(*(_finish - 1)));
+            std::move_backward(pos, _finish - 1, _finish);
+            *pos = std::move(tmp);
             _finish++;
             return pos;
         }
         /**
-         * @brief 移除指定位置的元素。
+         * @brief 在指定位置插入迭代器范围内的元素，最多扩容一次，尾部只移动一次。
+         * @tparam T_iterator 迭代器类型，至少为前向迭代器。
+         * @param pos 插入位置。
+         * @param first 范围开始迭代器。
+         * @param last 范围结束迭代器。
+         * @return 第一个新插入元素的位置迭代器。
+         */
+        template <class T_iterator,
+                  class = typename std::enable_if<!std::is_integral<T_iterator>::value>::type>
+        iterator insert(iterator pos, T_iterator first, T_iterator last)
+        {
+            size_t offset = pos - _start;
+            size_t k = std::distance(first, last);
+            if (k == 0)
+                return pos;
+            if (size() + k <= capacity() && InRange(first))
+            {
+                // 不扩容时腾挪尾部会覆盖源范围，先拷贝出来
+                Vector<T, Alloc, Growth> tmp(first, last);
+                return insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+            }
+            return InsertGap(offset, k, [&](iterator p)
+                             { Construct(p, *first); ++first; });
+        }
+        /**
+         * @brief 在指定位置插入 n 个相同的元素，最多扩容一次，尾部只移动一次。
+         * @param pos 插入位置。
+         * @param n 插入元素个数。
+         * @param value 要插入的元素。
+         * @return 第一个新插入元素的位置迭代器。
+         */
+        iterator insert(iterator pos, size_t n, const T &value)
+        {
+            if (n == 0)
+                return pos;
+            T tmp(value); // value 可能引用本容器内的元素
+            return InsertGap(pos - _start, n, [&](iterator p)
+                             { Construct(p, tmp); });
+        }
+        /**
+         * @brief 在末尾追加迭代器范围内的元素，最多扩容一次。
+         * @tparam T_iterator 迭代器类型，至少为前向迭代器。
+         * @param first 范围开始迭代器。
+         * @param last 范围结束迭代器。
+         */
+        template <class T_iterator>
+        void append(T_iterator first, T_iterator last) { insert(_finish, first, last); }
+        /**
+         * @brief 移除指定位置的元素，定义 XUSTL_DEBUG 时检查越界。
          * @param pos 要移除的元素位置。
          * @return 移除后的位置迭代器。
-         * @throws std::out_of_range 如果 pos 越界。
          */
         iterator erase(iterator pos)
         {
-            if (pos < _start || pos >= _finish)
-            {
-                throw std::out_of_range("越界移除！");
-            }
-            for (auto it = pos; it != _finish - 1; it++)
-                *it = std::move(*(it + 1));
+            XUSTL_DEBUG_CHECK(pos >= _start && pos < _finish, "越界移除！");
+            std::move(pos + 1, _finish, pos);
             _finish--;
+            alloc_traits::destroy(_alloc, _finish);
             return pos;
         }
+        /**
+         * @brief 移除 [first, last) 内的元素，尾部只移动一次，定义 XUSTL_DEBUG 时检查越界。
+         * @param first 范围开始迭代器。
+         * @param last 范围结束迭代器。
+         * @return 移除后原 last 位置元素的迭代器。
+         */
+        iterator erase(iterator first, iterator last)
+        {
+            XUSTL_DEBUG_CHECK(first >= _start && last <= _finish && first <= last, "越界移除！");
+            if (first == last)
+                return first;
+            Destroy(first, last);
+            size_t tail = _finish - last;
+            RelocateRange(last, _finish, first);
+            _finish = first + tail;
+            return first;
+        }
+
+        // 序列化
+        /**
+         * @brief 以二进制格式写入输出流，平凡可拷贝的元素整块写出。
+         * @param os 输出流。
+         * @throws std::runtime_error 写入失败时抛出。
+         */
+        void serialize(std::ostream &os) const
+        {
+            StreamWriter w(os);
+            SerializeTo(w);
+        }
+        /**
+         * @brief 以二进制格式写入文件描述符，平凡可拷贝的元素与文件头一起用 writev 写出。
+         * @param fd 文件描述符。
+         * @throws std::system_error 写入失败时抛出。
+         */
+        void serialize(int fd) const
+        {
+            FdWriter w(fd);
+            SerializeTo(w);
+        }
+        /**
+         * @brief 从输入流读取 serialize 写出的数据，替换当前内容。
+         * @param is 输入流。
+         * @throws std::runtime_error 数据不完整或格式不匹配时抛出。
+         */
+        void deserialize(std::istream &is)
+        {
+            StreamReader r(is);
+            DeserializeFrom(r);
+        }
+        /**
+         * @brief 从文件描述符读取 serialize 写出的数据，替换当前内容。
+         * @param fd 文件描述符。
+         * @throws std::runtime_error 数据不完整或格式不匹配时抛出。
+         * @throws std::system_error 读取失败时抛出。
+         */
+        void deserialize(int fd)
+        {
+            FdReader r(fd);
+            DeserializeFrom(r);
+        }
 
         // 其他
+    private:
+        /// @brief 在未初始化的内存上构造元素
+        /// @param p 目标地址
+        /// @param args 构造参数
+        template <class... Args>
+        void Construct(iterator p, Args &&...args)
+        {
+            alloc_traits::construct(_alloc, p, std::forward<Args>(args)...);
+        }
+        /// @brief 计算容纳 n 个元素所需的容量，装满后才按扩容策略扩容
+        /// @param n 需要容纳的元素个数
+        /// @return 新容量，无需扩容时返回当前容量
+        size_t NextCapacity(size_t n) const
+        {
+            size_t cp = capacity();
+            if (n <= cp)
+                return cp;
+            return Growth::next(cp, n, sizeof(T));
+        }
+        /// @brief 把现有元素搬到新内存并释放旧内存
+        /// @param new_start 新内存首地址
+        /// @param n 新内存容量
+        void Relocate(iterator new_start, size_t n)
+        {
+            size_t sz = size();
+            RelocateRange(_start, _finish, new_start);
+            if (_start != nullptr)
+                alloc_traits::deallocate(_alloc, _start, capacity());
+            _start = new_start;
+            _finish = _start + sz;
+            _end_of_storage = _start + n;
+        }
+        /// @brief 把 [first, last) 搬到 dst 开始的未初始化内存，源对象随后失效，dst 可与源重叠
+        /// @param first 源开始位置
+        /// @param last 源结束位置
+        /// @param dst 目标地址
+        void RelocateRange(iterator first, iterator last, iterator dst)
+        {
+            RelocateRange(first, last, dst, IsTriviallyRelocatable<T>());
+        }
+        /// @brief 可平凡重定位：整体 memmove，旧对象不再析构
+        void RelocateRange(iterator first, iterator last, iterator dst, std::true_type)
+        {
+            if (first != last)
+                std::memmove(static_cast<void *>(dst), static_cast<const void *>(first), (last - first) * sizeof(T));
+        }
+        /// @brief 一般类型：逐个移动构造后析构旧对象，按重叠方向选择遍历顺序
+        void RelocateRange(iterator first, iterator last, iterator dst, std::false_type)
+        {
+            if (dst <= first)
+            {
+                for (; first != last; ++first, ++dst)
+                {
+                    Construct(dst, std::move_if_noexcept(*first));
+                    alloc_traits::destroy(_alloc, first);
+                }
+                return;
+            }
+            dst += last - first;
+            while (last != first)
+            {
+                --last, --dst;
+                Construct(dst, std::move_if_noexcept(*last));
+                alloc_traits::destroy(_alloc, last);
+            }
+        }
+        /// @brief 在 offset 处腾出 k 个位置并逐个调用 fill 构造，最多扩容一次、尾部只搬迁一次
+        /// @tparam Filler 可调用对象，参数为待构造的地址
+        /// @param offset 插入位置下标
+        /// @param k 插入元素个数
+        /// @param fill 构造函数对象
+        /// @return 第一个新元素的迭代器
+        template <class Filler>
+        iterator InsertGap(size_t offset, size_t k, Filler fill)
+        {
+            size_t sz = size();
+            size_t i = 0;
+            if (sz + k > capacity())
+            {
+                // 先在新内存中构造新元素，此时旧元素仍然有效，源范围可以指向本容器
+                size_t new_cp = NextCapacity(sz + k);
+                iterator new_start = alloc_traits::allocate(_alloc, new_cp);
+                iterator gap = new_start + offset;
+                try
+                {
+                    for (; i < k; i++)
+                        fill(gap + i);
+                }
+                catch (...)
+                {
+                    Destroy(gap, gap + i);
+                    alloc_traits::deallocate(_alloc, new_start, new_cp);
+                    throw;
+                }
+                RelocateRange(_start, _start + offset, new_start);
+                RelocateRange(_start + offset, _finish, gap + k);
+                if (_start != nullptr)
+                    alloc_traits::deallocate(_alloc, _start, capacity());
+                _start = new_start;
+                _finish = _start + sz + k;
+                _end_of_storage = _start + new_cp;
+                return gap;
+            }
+            iterator gap = _start + offset;
+            RelocateRange(gap, _finish, gap + k);
+            _finish += k;
+            try
+            {
+                for (; i < k; i++)
+                    fill(gap + i);
+            }
+            catch (...)
+            {
+                Destroy(gap, gap + i);
+                RelocateRange(gap + k, _finish, gap);
+                _finish -= k;
+                throw;
+            }
+            return gap;
+        }
+        /// @brief 判断迭代器所指的元素是否位于本容器内部
+        /// @details 按元素地址判断，指针、反向迭代器、移动迭代器等解引用得到 T 的引用的迭代器都适用；
+        ///          解引用得到值或其他类型的迭代器不可能指向本容器的存储区。
+        template <class T_iterator>
+        bool InRange(const T_iterator &it) const
+        {
+            using reference = typename std::iterator_traits<T_iterator>::reference;
+            return InRange(it, std::integral_constant<bool, std::is_reference<reference>::value &&
+                                                                std::is_same<typename std::decay<reference>::type, T>::value>());
+        }
+        template <class T_iterator>
+        bool InRange(const T_iterator &it, std::true_type) const
+        {
+            const T *p = std::addressof(static_cast<const T &>(*it));
+            return p >= _start && p < _finish;
+        }
+        template <class T_iterator>
+        bool InRange(const T_iterator &, std::false_type) const { return false; }
+        /// @brief 通过分配器 reallocate 调整容量，页可由内核直接移动
+        /// @param n 新容量，不小于 size()
+        void Reallocate(size_t n, std::true_type)
+        {
+            size_t sz = size();
+            _start = _alloc.reallocate(_start, capacity(), n);
+            _finish = _start + sz;
+            _end_of_storage = _start + n;
+        }
+        /// @brief 分配新内存并搬迁元素
+        /// @param n 新容量，不小于 size()
+        void Reallocate(size_t n, std::false_type)
+        {
+            Relocate(alloc_traits::allocate(_alloc, n), n);
+        }
+        /// @brief 析构 [first, last) 内的元素，不释放内存
+        void Destroy(iterator first, iterator last)
+        {
+            for (; first != last; ++first)
+                alloc_traits::destroy(_alloc, first);
+        }
+        /// @brief 写出文件头和全部元素
+        template <class Writer>
+        void SerializeTo(Writer &w) const
+        {
+            const bool bulk = std::is_trivially_copyable<T>::value;
+            WriteSerialHeader(w, SerialKind::Vector, bulk, sizeof(T), size());
+            if (bulk)
+                w.write_bulk(_start, size() * sizeof(T));
+            else
+                for (const T *p = _start; p != _finish; ++p)
+                    Serializer<T>::write(w, *p);
+            w.flush();
+        }
+        /// @brief 读取文件头和全部元素，平凡可拷贝的元素按块直接读入存储区
+        template <class Reader>
+        void DeserializeFrom(Reader &r)
+        {
+            const bool bulk = std::is_trivially_copyable<T>::value;
+            SerialHeader h = ReadSerialHeader(r, SerialKind::Vector, sizeof(T), bulk);
+            clear();
+            // h.count 来自外部数据，不能据此一次分配：最多预留一块，之后随读到的数据扩容
+            const size_t chunk = (1 << 20) / sizeof(T) + 1; // 每次约 1MB
+            reserve(h.count < chunk ? h.count : chunk);
+            if (bulk)
+            {
+                for (size_t left = h.count; left != 0;)
+                {
+                    size_t k = left < chunk ? left : chunk;
+                    reserve(NextCapacity(size() + k));
+                    r.read(_finish, k * sizeof(T));
+                    _finish += k;
+                    left -= k;
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < h.count; i++)
+                {
+                    T value;
+                    Serializer<T>::read(r, value);
+                    emplace_back(std::move(value));
+                }
+            }
+        }
+        /// @brief 析构全部元素并归还内存
+        void Release()
+        {
+            if (_start != nullptr)
+            {
+                Destroy(_start, _finish);
+                alloc_traits::deallocate(_alloc, _start, capacity());
+            }
+            _start = nullptr;
+            _finish = nullptr;
+            _end_of_storage = nullptr;
+        }
+
     private:
         iterator _start;          ///< 元素开始迭代器
         iterator _finish;         ///< 元素结束迭代器
         iterator _end_of_storage; ///< 内存末尾迭代器
+        Alloc _alloc;             ///< 分配器
     };
-}
\ No newline at end of file
+}
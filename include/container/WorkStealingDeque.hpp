@@ -0,0 +1,146 @@
+/// @file WorkStealingDeque.hpp
+/// @brief Chase–Lev 工作窃取双端队列
+#pragma once
+#include "Vector.hpp"
+#include "../utility/CacheLine.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace XuSTL
+{
+    /// @brief Chase–Lev 工作窃取双端队列
+    /// @details 所有者在底部 push 和 pop（后进先出，缓存友好），其他线程在顶部 steal（先进先出，偷走最早、通常最大的任务）。
+    ///          只有底部剩最后一个元素、所有者与窃取者争抢时才需要 CAS。环形数组满时所有者把它扩大一倍，
+    ///          旧数组可能还在被窃取者读取，留到队列析构时才释放。内存序采用 Lê 等人给出的 C11 版本。
+    /// @tparam T 数据类型，须可平凡拷贝（通常是任务指针）
+    template <class T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque 的元素须可平凡拷贝");
+        /// @brief 环形数组
+        struct Array
+        {
+            int64_t _cap;           ///< 容量，2 的幂
+            std::atomic<T> *_slots; ///< 槽位
+
+            explicit Array(int64_t cap) : _cap(cap), _slots(new std::atomic<T>[cap]) {}
+            ~Array() { delete[] _slots; }
+            T get(int64_t i) const { return _slots[i & (_cap - 1)].load(std::memory_order_relaxed); }
+            void put(int64_t i, T value) { _slots[i & (_cap - 1)].store(value, std::memory_order_relaxed); }
+        };
+
+    public:
+        /**
+         * @brief 构造函数
+         * @param capacity 初始容量，向上取整到 2 的幂
+         */
+        explicit WorkStealingDeque(size_t capacity = 64) : _top(0), _bottom(0)
+        {
+            int64_t cap = 2;
+            while (cap < static_cast<int64_t>(capacity))
+                cap <<= 1;
+            _array.store(new Array(cap), std::memory_order_relaxed);
+        }
+        WorkStealingDeque(const WorkStealingDeque &) = delete;
+        WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+        /**
+         * @brief 析构函数，此时不能再有线程访问队列
+         */
+        ~WorkStealingDeque()
+        {
+            delete _array.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < _garbage.size(); i++)
+                delete _garbage[i];
+        }
+
+        /// @brief 在底部放入，只能由所有者调用
+        /// @param value 数据
+        void push(T value)
+        {
+            int64_t b = _bottom.load(std::memory_order_relaxed);
+            int64_t t = _top.load(std::memory_order_acquire);
+            Array *a = _array.load(std::memory_order_relaxed);
+            if (b - t > a->_cap - 1)
+                a = Grow(a, t, b);
+            a->put(b, value);
+            _bottom.store(b + 1, std::memory_order_release); // 与 steal 读 _bottom 配对，发布元素
+        }
+        /// @brief 从底部取出，只能由所有者调用
+        /// @param out 接收元素
+        /// @return 成功返回 true，队列空或最后一个元素被窃取返回 false
+        bool pop(T &out)
+        {
+            int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+            Array *a = _array.load(std::memory_order_relaxed);
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = _top.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = a->get(b);
+            if (t == b) // 最后一个元素，与窃取者争抢
+            {
+                bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+        /// @brief 从顶部窃取，任何线程都可以调用
+        /// @param out 接收元素
+        /// @return 成功返回 true，队列空或与其他线程争抢失败返回 false
+        bool steal(T &out)
+        {
+            int64_t t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = _bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return false;
+            Array *a = _array.load(std::memory_order_acquire);
+            T value = a->get(t);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return false;
+            out = value;
+            return true;
+        }
+        /**
+         * @brief 获取元素个数，并发时只是近似值
+         * @return 元素个数
+         */
+        size_t size() const
+        {
+            int64_t b = _bottom.load(std::memory_order_relaxed);
+            int64_t t = _top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_t>(b - t) : 0;
+        }
+        /**
+         * @brief 检查是否为空，并发时只是近似值
+         * @return 为空返回 true，否则返回 false
+         */
+        bool empty() const { return size() == 0; }
+
+    private:
+        /// @brief 换成两倍容量的数组，旧数组放入待释放列表
+        Array *Grow(Array *a, int64_t t, int64_t b)
+        {
+            Array *bigger = new Array(a->_cap * 2);
+            for (int64_t i = t; i < b; i++)
+                bigger->put(i, a->get(i));
+            _garbage.push_back(a);
+            _array.store(bigger, std::memory_order_release);
+            return bigger;
+        }
+
+    private:
+        std::atomic<int64_t> _top;                                ///< 顶部，窃取者推进
+        char _pad1[CacheLineSize - sizeof(std::atomic<int64_t>)]; ///< 与 _bottom 隔开
+        std::atomic<int64_t> _bottom;                             ///< 底部，只有所有者写
+        char _pad2[CacheLineSize - sizeof(std::atomic<int64_t>)]; ///< 与 _array 隔开
+        std::atomic<Array *> _array;                              ///< 当前数组
+        Vector<Array *> _garbage;                                 ///< 扩容换下的旧数组，只有所有者访问
+    };
+}
@@ -0,0 +1,216 @@
+/// @file Epoch.hpp
+/// @brief 基于纪元的内存回收
+#pragma once
+#include "../container/Vector.hpp"
+#include "../utility/CacheLine.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace XuSTL
+{
+    /// @brief 基于纪元的内存回收（EBR），供无锁容器推迟释放已摘下的节点
+    /// @details 线程在访问共享节点前用 EpochGuard 进入临界区，记下当时的全局纪元。
+    ///          摘下的节点交给 retire，标记为当时的纪元 e；只有当所有处于临界区的线程都已看到纪元 e，
+    ///          全局纪元才能前进，前进到 e + 2 时再没有线程可能持有该节点，此时才真正释放。
+    ///          因此临界区内读到的节点地址在退出前不会被释放和复用，无锁容器的 CAS 不会遇到 ABA 问题。
+    ///          每个线程第一次使用时登记一条记录，线程退出时记录留给之后的线程复用，未释放的节点转交给全局。
+    ///          整个进程共用一个实例。
+    class EpochDomain
+    {
+        /// @brief 待释放的节点
+        struct Retired
+        {
+            void *_ptr;               ///< 节点
+            void (*_deleter)(void *); ///< 释放函数
+            uint64_t _epoch;          ///< 摘下时的全局纪元
+        };
+        /// @brief 每个线程一条记录，只追加不删除
+        struct Record
+        {
+            std::atomic<uint64_t> _state{0};                          ///< 0 表示不在临界区，否则为 (纪元 << 1) | 1
+            char _pad[CacheLineSize - sizeof(std::atomic<uint64_t>)]; ///< 其他线程频繁读 _state，与下面的字段隔开
+            std::atomic<bool> _owned{true};                           ///< 是否有线程在使用
+            Record *_next = nullptr;                                  ///< 下一条记录，发布后不变
+            unsigned _depth = 0;                                      ///< 临界区嵌套层数，只有所属线程访问
+            unsigned _since_collect = 0;                              ///< 上次回收以来 retire 的次数
+            Vector<Retired> _retired;                                 ///< 本线程摘下的节点
+        };
+        /// @brief 线程退出时归还记录
+        struct ThreadHandle
+        {
+            Record *_record = nullptr; ///< 本线程的记录
+
+            ~ThreadHandle()
+            {
+                if (_record != nullptr)
+                    instance().Release(_record);
+            }
+        };
+
+        static const unsigned CollectThreshold = 64; ///< 每 retire 这么多次尝试回收一次
+
+    public:
+        /// @brief 进程唯一的实例
+        static EpochDomain &instance()
+        {
+            static EpochDomain domain;
+            return domain;
+        }
+        EpochDomain(const EpochDomain &) = delete;
+        EpochDomain &operator=(const EpochDomain &) = delete;
+
+        /// @brief 当前线程进入临界区，可以嵌套
+        void enter()
+        {
+            Record *r = Local();
+            if (r->_depth++ > 0)
+                return;
+            r->_state.store((_epoch.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // 登记先于之后对共享节点的读取
+        }
+        /// @brief 当前线程退出临界区
+        void leave()
+        {
+            Record *r = Local();
+            if (--r->_depth == 0)
+                r->_state.store(0, std::memory_order_release);
+        }
+        /// @brief 推迟释放一个已从共享结构中摘下的节点
+        /// @param p 节点，之后新进入临界区的线程不能再访问到它
+        /// @param deleter 安全时调用的释放函数
+        void retire(void *p, void (*deleter)(void *))
+        {
+            Record *r = Local();
+            r->_retired.push_back(Retired{p, deleter, _epoch.load(std::memory_order_acquire)});
+            if (++r->_since_collect >= CollectThreshold)
+                collect();
+        }
+        /// @brief 推迟 delete 一个节点
+        /// @tparam T 节点类型
+        /// @param p 用 new 分配的节点
+        template <class T>
+        void retire(T *p)
+        {
+            retire(p, [](void *q)
+                   { delete static_cast<T *>(q); });
+        }
+        /// @brief 尝试推进全局纪元，并释放当前线程（及已退出线程）中已经安全的节点
+        void collect()
+        {
+            Record *r = Local();
+            r->_since_collect = 0;
+            TryAdvance();
+            uint64_t safe = _epoch.load(std::memory_order_acquire);
+            Reclaim(r->_retired, safe);
+            std::unique_lock<std::mutex> lock(_orphan_mutex, std::try_to_lock);
+            if (lock.owns_lock())
+                Reclaim(_orphans, safe);
+        }
+        /**
+         * @brief 当前线程尚未释放的节点数
+         * @return 节点数
+         */
+        size_t pending() { return Local()->_retired.size(); }
+        /**
+         * @brief 获取全局纪元
+         * @return 纪元
+         */
+        uint64_t epoch() const { return _epoch.load(std::memory_order_acquire); }
+
+    private:
+        EpochDomain() : _epoch(0), _records(nullptr) {}
+        /// @brief 进程退出时已没有其他线程，释放全部节点和记录
+        ~EpochDomain()
+        {
+            Reclaim(_orphans, UINT64_MAX);
+            Record *r = _records.load(std::memory_order_acquire);
+            while (r != nullptr)
+            {
+                Record *next = r->_next;
+                Reclaim(r->_retired, UINT64_MAX);
+                delete r;
+                r = next;
+            }
+        }
+        /// @brief 当前线程的记录，第一次调用时登记
+        Record *Local()
+        {
+            thread_local ThreadHandle handle;
+            if (handle._record == nullptr)
+                handle._record = Acquire();
+            return handle._record;
+        }
+        /// @brief 复用已退出线程的记录，没有则新建一条
+        Record *Acquire()
+        {
+            for (Record *r = _records.load(std::memory_order_acquire); r != nullptr; r = r->_next)
+            {
+                bool expected = false;
+                if (!r->_owned.load(std::memory_order_relaxed) && r->_owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return r;
+            }
+            Record *r = new Record;
+            r->_next = _records.load(std::memory_order_relaxed);
+            while (!_records.compare_exchange_weak(r->_next, r, std::memory_order_release, std::memory_order_relaxed))
+                ;
+            return r;
+        }
+        /// @brief 线程退出：未释放的节点转交给全局，记录留给之后的线程
+        void Release(Record *r)
+        {
+            r->_state.store(0, std::memory_order_release);
+            r->_depth = 0;
+            {
+                std::lock_guard<std::mutex> lock(_orphan_mutex);
+                for (size_t i = 0; i < r->_retired.size(); i++)
+                    _orphans.push_back(r->_retired[i]);
+            }
+            r->_retired.clear();
+            r->_since_collect = 0;
+            r->_owned.store(false, std::memory_order_release);
+        }
+        /// @brief 所有在临界区内的线程都已看到当前纪元时，把纪元加一
+        void TryAdvance()
+        {
+            uint64_t e = _epoch.load(std::memory_order_seq_cst);
+            for (Record *r = _records.load(std::memory_order_acquire); r != nullptr; r = r->_next)
+            {
+                uint64_t s = r->_state.load(std::memory_order_seq_cst);
+                if ((s & 1) && (s >> 1) != e)
+                    return;
+            }
+            _epoch.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+        }
+        /// @brief 释放纪元不晚于 safe - 2 的节点，其余保留
+        static void Reclaim(Vector<Retired> &list, uint64_t safe)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < list.size(); i++)
+            {
+                if (list[i]._epoch + 2 <= safe || safe == UINT64_MAX)
+                    list[i]._deleter(list[i]._ptr);
+                else
+                    list[kept++] = list[i];
+            }
+            while (list.size() > kept)
+                list.pop_back();
+        }
+
+    private:
+        alignas(CacheLineSize) std::atomic<uint64_t> _epoch; ///< 全局纪元
+        std::atomic<Record *> _records;                      ///< 全部线程记录
+        std::mutex _orphan_mutex;                            ///< 保护 _orphans
+        Vector<Retired> _orphans;                            ///< 已退出线程留下的节点
+    };
+
+    /// @brief 在作用域内让当前线程处于 EpochDomain 的临界区
+    class EpochGuard
+    {
+    public:
+        EpochGuard() { EpochDomain::instance().enter(); }
+        ~EpochGuard() { EpochDomain::instance().leave(); }
+        EpochGuard(const EpochGuard &) = delete;
+        EpochGuard &operator=(const EpochGuard &) = delete;
+    };
+}
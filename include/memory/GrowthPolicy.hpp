@@ -0,0 +1,65 @@
+/// @file GrowthPolicy.hpp
+/// @brief 动态数组扩容策略
+#pragma once
+#include <cstddef>
+#include <algorithm>
+
+namespace XuSTL
+{
+    /// @brief 几何扩容，新容量为旧容量的 Num / Den 倍
+    /// @tparam Num 倍数分子
+    /// @tparam Den 倍数分母
+    template <size_t Num = 3, size_t Den = 2>
+    struct GeometricGrowth
+    {
+        static_assert(Num > Den, "扩容倍数必须大于 1");
+        /// @brief 计算新容量
+        /// @param cap 当前容量
+        /// @param need 需要容纳的元素个数，大于 cap
+        /// @return 不小于 need 的新容量
+        static size_t next(size_t cap, size_t need, size_t /*elem_size*/)
+        {
+            return std::max(need, cap * Num / Den);
+        }
+    };
+
+    /// @brief 容量取不小于所需个数的 2 的幂
+    struct PowerOfTwoGrowth
+    {
+        /// @brief 计算新容量
+        /// @param cap 当前容量
+        /// @param need 需要容纳的元素个数，大于 cap
+        /// @return 不小于 need 的 2 的幂
+        static size_t next(size_t /*cap*/, size_t need, size_t /*elem_size*/)
+        {
+            size_t n = 1;
+            while (n < need)
+                n <<= 1;
+            return n;
+        }
+    };
+
+    /// @brief 在 Base 策略的基础上把字节数向上取整到 Page 的整数倍
+    /// @details 适合大数组，使分配的内存恰好占满整页，不浪费页尾
+    /// @tparam Page 页大小（字节）
+    /// @tparam Base 基础扩容策略
+    template <size_t Page = 4096, class Base = GeometricGrowth<>>
+    struct PageGrowth
+    {
+        static_assert((Page & (Page - 1)) == 0, "页大小必须是 2 的幂");
+        /// @brief 计算新容量
+        /// @param cap 当前容量
+        /// @param need 需要容纳的元素个数，大于 cap
+        /// @param elem_size 元素大小（字节）
+        /// @return 不小于 need 且占满整页的新容量
+        static size_t next(size_t cap, size_t need, size_t elem_size)
+        {
+            size_t bytes = Base::next(cap, need, elem_size) * elem_size;
+            bytes = (bytes + Page - 1) & ~(Page - 1);
+            return bytes / elem_size;
+        }
+    };
+
+    /// @brief 按 2MB 大页取整的扩容策略
+    using HugePageGrowth = PageGrowth<2 * 1024 * 1024>;
+}
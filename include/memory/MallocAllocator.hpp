@@ -0,0 +1,58 @@
+/// @file MallocAllocator.hpp
+/// @brief 基于 malloc/realloc 的分配器
+#pragma once
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace XuSTL
+{
+    /// @brief 使用 malloc/free 管理内存的分配器
+    /// @details 额外提供 reallocate，配合可平凡重定位的元素时 Vector 扩容直接走 realloc。
+    ///          glibc 对大块内存使用 mmap 分配，realloc 时通过 mremap 移动页表而不拷贝数据。
+    /// @tparam T 数据类型
+    template <class T>
+    class MallocAllocator
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc 无法满足该类型的对齐要求");
+
+    public:
+        using value_type = T; ///< 数据类型
+
+        MallocAllocator() noexcept {}
+        template <class U>
+        MallocAllocator(const MallocAllocator<U> &) noexcept {}
+
+        /// @brief 分配 n 个元素的内存
+        /// @param n 元素个数
+        /// @return 内存首地址
+        /// @throws std::bad_alloc 分配失败时抛出
+        T *allocate(size_t n)
+        {
+            void *p = std::malloc(n * sizeof(T));
+            if (p == nullptr && n != 0)
+                throw std::bad_alloc();
+            return static_cast<T *>(p);
+        }
+        /// @brief 释放内存
+        /// @param p 内存首地址
+        void deallocate(T *p, size_t) noexcept { std::free(p); }
+        /// @brief 扩容或缩容，保留前 min(old_n, new_n) 个元素的字节内容
+        /// @param p 原内存首地址
+        /// @param new_n 新的元素个数
+        /// @return 新内存首地址，失败时原内存保持不变
+        /// @throws std::bad_alloc 分配失败时抛出
+        T *reallocate(T *p, size_t /*old_n*/, size_t new_n)
+        {
+            void *q = std::realloc(p, new_n * sizeof(T));
+            if (q == nullptr && new_n != 0)
+                throw std::bad_alloc();
+            return static_cast<T *>(q);
+        }
+    };
+
+    template <class T, class U>
+    bool operator==(const MallocAllocator<T> &, const MallocAllocator<U> &) { return true; }
+    template <class T, class U>
+    bool operator!=(const MallocAllocator<T> &, const MallocAllocator<U> &) { return false; }
+}
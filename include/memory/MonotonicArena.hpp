@@ -0,0 +1,147 @@
+/// @file MonotonicArena.hpp
+/// @brief 单调内存区及其分配器
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace XuSTL
+{
+    /// @brief 单调内存区，只做指针递增分配，单次释放是空操作，内存在 reset 或析构时一次性归还
+    /// @details 当前块用完时申请一块更大的新块（翻倍），适合“建一批容器、用完整体丢弃”的场景。
+    ///          不是线程安全的。
+    class MonotonicArena
+    {
+        /// @brief 块头，数据紧随其后
+        struct Block
+        {
+            Block *_next; ///< 上一块
+            size_t _size; ///< 块的总字节数，含块头
+        };
+
+    public:
+        /// @brief 构造函数，不立即申请内存
+        /// @param block_size 第一块的字节数
+        explicit MonotonicArena(size_t block_size = 4096)
+            : _blocks(nullptr), _cur(nullptr), _end(nullptr), _next_size(block_size < 2 * sizeof(Block) ? 2 * sizeof(Block) : block_size), _allocated(0) {}
+        MonotonicArena(const MonotonicArena &) = delete;
+        MonotonicArena &operator=(const MonotonicArena &) = delete;
+        ~MonotonicArena() { release(); }
+
+        /// @brief 分配内存
+        /// @param bytes 字节数
+        /// @param align 对齐，必须是 2 的幂
+        /// @return 内存首地址
+        /// @throws std::bad_alloc 申请新块失败时抛出
+        void *allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+        {
+            char *p = AlignUp(_cur, align);
+            if (_cur == nullptr || p + bytes > _end)
+            {
+                NewBlock(bytes + align);
+                p = AlignUp(_cur, align);
+            }
+            _cur = p + bytes;
+            _allocated += bytes;
+            return p;
+        }
+        /// @brief 单次释放，什么也不做
+        void deallocate(void *, size_t) noexcept {}
+        /// @brief 之前分配的内存全部失效，保留最大的一块供之后复用，其余块归还
+        void reset() noexcept
+        {
+            if (_blocks == nullptr)
+                return;
+            Block *keep = _blocks; // 最后申请的块最大
+            Block *b = keep->_next;
+            while (b != nullptr)
+            {
+                Block *next = b->_next;
+                ::operator delete(b);
+                b = next;
+            }
+            keep->_next = nullptr;
+            _blocks = keep;
+            _cur = reinterpret_cast<char *>(keep + 1);
+            _end = reinterpret_cast<char *>(keep) + keep->_size;
+            _allocated = 0;
+        }
+        /// @brief 归还全部内存
+        void release() noexcept
+        {
+            while (_blocks != nullptr)
+            {
+                Block *next = _blocks->_next;
+                ::operator delete(_blocks);
+                _blocks = next;
+            }
+            _cur = _end = nullptr;
+            _allocated = 0;
+        }
+        /// @brief 上次 reset 以来分配出去的字节数
+        size_t allocated() const { return _allocated; }
+
+    private:
+        /// @brief 把指针向上取整到 align 的整数倍
+        static char *AlignUp(char *p, size_t align)
+        {
+            uintptr_t v = reinterpret_cast<uintptr_t>(p);
+            return reinterpret_cast<char *>((v + align - 1) & ~static_cast<uintptr_t>(align - 1));
+        }
+        /// @brief 申请至少能放下 need 字节的新块
+        void NewBlock(size_t need)
+        {
+            size_t size = _next_size;
+            while (size < need + sizeof(Block))
+                size *= 2;
+            Block *b = static_cast<Block *>(::operator new(size));
+            b->_next = _blocks;
+            b->_size = size;
+            _blocks = b;
+            _cur = reinterpret_cast<char *>(b + 1);
+            _end = reinterpret_cast<char *>(b) + size;
+            _next_size = size * 2;
+        }
+
+    private:
+        Block *_blocks;    ///< 已申请的块，最新的在前
+        char *_cur;        ///< 当前块中下一个可分配的位置
+        char *_end;        ///< 当前块的末尾
+        size_t _next_size; ///< 下一块的字节数
+        size_t _allocated; ///< 已分配字节数
+    };
+
+    /// @brief 从 MonotonicArena 分配内存的分配器，deallocate 为空操作
+    /// @details 容器使用它时，容器析构不逐个释放内存，内存随 arena 的 reset 一次性回收。
+    /// @tparam T 数据类型
+    template <class T>
+    class ArenaAllocator
+    {
+        template <class U>
+        friend class ArenaAllocator;
+
+    public:
+        using value_type = T; ///< 数据类型
+
+        /// @brief 构造函数
+        /// @param arena 内存区，生命周期须长于使用它的容器
+        ArenaAllocator(MonotonicArena *arena) noexcept : _arena(arena) {}
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : _arena(other._arena) {}
+
+        /// @brief 分配 n 个元素的内存
+        T *allocate(size_t n) { return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T))); }
+        /// @brief 什么也不做
+        void deallocate(T *, size_t) noexcept {}
+        /// @brief 所用的内存区
+        MonotonicArena *arena() const { return _arena; }
+
+    private:
+        MonotonicArena *_arena; ///< 内存区
+    };
+
+    template <class T, class U>
+    bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena() == b.arena(); }
+    template <class T, class U>
+    bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) { return a.arena() != b.arena(); }
+}
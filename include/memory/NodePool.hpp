@@ -0,0 +1,202 @@
+/// @file NodePool.hpp
+/// @brief 定长节点池
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace XuSTL
+{
+    /// @brief 为单个容器分配定长节点的内存池
+    /// @details 节点从成块申请的内存中依次切出，释放的节点挂到空闲链表上供下次复用，
+    ///          块的大小从 MinBlockNodes 个节点开始翻倍，直到 MaxBlockBytes。
+    ///          池析构或 release 时整块归还，不逐个释放节点。只管理内存，不构造和析构节点。
+    ///          块通过 Alloc 申请，块头占用块开头的若干个节点位置。
+    ///          两个池可以通过 share 共享块的所有权，使节点能在容器之间转移（如 List::splice）。
+    /// @tparam Node 节点类型
+    /// @tparam Alloc 分配器，会被重绑定到内部的节点槽类型
+    template <class Node, class Alloc = std::allocator<Node>>
+    class NodePool
+    {
+        /// @brief 空闲时存放链表指针，使用时存放节点
+        union Slot
+        {
+            Slot *_next;
+            typename std::aligned_storage<sizeof(Node), alignof(Node)>::type _storage;
+        };
+        /// @brief 块头，节点紧随其后
+        struct Block
+        {
+            Block *_next;  ///< 上一块
+            size_t _slots; ///< 块的总槽数，含块头
+        };
+        using slot_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>; ///< 槽分配器
+        using slot_traits = std::allocator_traits<slot_allocator>;                                   ///< 槽分配器萃取
+        /// @brief 共享的块链，最后一个引用它的池释放时归还全部块
+        struct Chain
+        {
+            Block *_blocks;                  ///< 块
+            std::shared_ptr<Chain> _forward; ///< 被合并到的块链，非空时本链已无块
+            slot_allocator _alloc;           ///< 块分配器
+
+            Chain(Block *blocks, const slot_allocator &alloc) : _blocks(blocks), _alloc(alloc) {}
+            ~Chain() { FreeBlocks(_blocks, _alloc); }
+        };
+
+        static const size_t MinBlockNodes = 16;                                              ///< 第一块的节点数
+        static const size_t MaxBlockBytes = 256 * 1024;                                      ///< 块大小上限（字节）
+        static const size_t HeaderSlots = (sizeof(Block) + sizeof(Slot) - 1) / sizeof(Slot); ///< 块头占用的槽数
+
+    public:
+        /// @brief 构造函数，不立即申请内存
+        /// @param alloc 分配器
+        explicit NodePool(const Alloc &alloc = Alloc()) noexcept
+            : _free(nullptr), _cur(nullptr), _end(nullptr), _blocks(nullptr), _block_nodes(MinBlockNodes), _alloc(alloc) {}
+        NodePool(const NodePool &) = delete;
+        NodePool &operator=(const NodePool &) = delete;
+        /// @brief 移动构造，接管另一个池的全部内存
+        NodePool(NodePool &&other) noexcept : NodePool(Alloc(other._alloc)) { swap(other); }
+        /// @brief 移动赋值，先归还自己的内存再接管另一个池的内存
+        NodePool &operator=(NodePool &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+        ~NodePool() { release(); }
+
+        /// @brief 分配一个节点的内存
+        /// @return 未初始化的节点内存
+        /// @throws std::bad_alloc 申请新块失败时抛出
+        void *allocate()
+        {
+            if (_free != nullptr)
+            {
+                Slot *s = _free;
+                _free = s->_next;
+                return s;
+            }
+            if (_cur == _end)
+                NewBlock();
+            return _cur++;
+        }
+        /// @brief 归还一个节点的内存，放入空闲链表
+        /// @param p allocate 返回的地址，节点须已析构
+        void deallocate(void *p) noexcept
+        {
+            Slot *s = static_cast<Slot *>(p);
+            s->_next = _free;
+            _free = s;
+        }
+        /// @brief 整块归还全部内存，之前分配的节点全部失效；与其他池共享时只放弃所有权
+        void release() noexcept
+        {
+            if (_chain)
+                _chain.reset();
+            else
+                FreeBlocks(_blocks, _alloc);
+            _free = nullptr;
+            _cur = _end = nullptr;
+            _block_nodes = MinBlockNodes;
+        }
+        /// @brief 交换两个池
+        void swap(NodePool &other) noexcept
+        {
+            std::swap(_free, other._free);
+            std::swap(_cur, other._cur);
+            std::swap(_end, other._end);
+            std::swap(_blocks, other._blocks);
+            std::swap(_block_nodes, other._block_nodes);
+            std::swap(_alloc, other._alloc);
+            _chain.swap(other._chain);
+        }
+        /// @brief 与另一个池共享块的所有权，之后任一池分配的节点都可以交给另一个池释放
+        /// @details 两个池的块合并到同一条块链上，直到所有共享它的池都释放后才归还。
+        ///          两个池的分配器必须相等。
+        /// @param other 另一个池
+        void share(NodePool &other)
+        {
+            if (this == &other)
+                return;
+            Chain *mine = Adopt();
+            Chain *theirs = other.Adopt();
+            if (mine == theirs)
+                return;
+            if (theirs->_blocks != nullptr)
+            {
+                Block *tail = theirs->_blocks;
+                while (tail->_next != nullptr)
+                    tail = tail->_next;
+                tail->_next = mine->_blocks;
+                mine->_blocks = theirs->_blocks;
+                theirs->_blocks = nullptr;
+            }
+            theirs->_forward = _chain; // 仍引用 theirs 的其他池经由它找到合并后的块链
+            other._chain = _chain;
+        }
+        /// @brief 获取分配器
+        Alloc get_allocator() const { return Alloc(_alloc); }
+
+    private:
+        /// @brief 归还一条块链上的全部块
+        static void FreeBlocks(Block *&blocks, slot_allocator &alloc) noexcept
+        {
+            while (blocks != nullptr)
+            {
+                Block *b = blocks;
+                blocks = b->_next;
+                slot_traits::deallocate(alloc, reinterpret_cast<Slot *>(b), b->_slots);
+            }
+        }
+        /// @brief 把自己的块转入共享块链
+        /// @return 合并后的块链
+        Chain *Adopt()
+        {
+            if (!_chain)
+            {
+                _chain = std::make_shared<Chain>(_blocks, _alloc);
+                _blocks = nullptr;
+            }
+            return Root();
+        }
+        /// @brief 沿 _forward 找到实际持有块的块链，并直接引用它
+        Chain *Root()
+        {
+            while (_chain->_forward)
+            {
+                std::shared_ptr<Chain> next = _chain->_forward;
+                _chain = next;
+            }
+            return _chain.get();
+        }
+        /// @brief 申请新块，之后的节点从新块切出
+        void NewBlock()
+        {
+            size_t slots = HeaderSlots + _block_nodes;
+            Slot *mem = slot_traits::allocate(_alloc, slots);
+            Block *b = reinterpret_cast<Block *>(mem);
+            Block *&blocks = _chain ? Root()->_blocks : _blocks;
+            b->_next = blocks;
+            b->_slots = slots;
+            blocks = b;
+            _cur = mem + HeaderSlots;
+            _end = mem + slots;
+            if (_block_nodes * 2 * sizeof(Slot) <= MaxBlockBytes)
+                _block_nodes *= 2;
+        }
+
+    private:
+        Slot *_free;                   ///< 空闲链表
+        Slot *_cur;                    ///< 当前块中下一个未切出的节点
+        Slot *_end;                    ///< 当前块的末尾
+        Block *_blocks;                ///< 已申请的块
+        size_t _block_nodes;           ///< 下一块的节点数
+        slot_allocator _alloc;         ///< 块分配器
+        std::shared_ptr<Chain> _chain; ///< 与其他池共享时的块链，此时 _blocks 为空
+    };
+}
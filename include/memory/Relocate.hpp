@@ -0,0 +1,43 @@
+/// @file Relocate.hpp
+/// @brief 可平凡重定位类型萃取
+#pragma once
+#include <type_traits>
+
+namespace XuSTL
+{
+    /// @brief 判断类型能否用 memcpy 整体搬迁（搬迁后不再调用旧对象的析构）
+    /// @details 平凡可拷贝类型默认为 true，自定义类型可特化为 std::true_type 主动开启，
+    ///          也可以使用 XUSTL_TRIVIALLY_RELOCATABLE 宏
+    /// @tparam T 数据类型
+    template <class T>
+    struct IsTriviallyRelocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+    {
+    };
+
+    /// @brief 判断分配器是否提供 reallocate(p, old_n, new_n) 原地扩容接口
+    /// @tparam Alloc 分配器类型
+    template <class Alloc>
+    struct HasReallocate
+    {
+    private:
+        template <class A>
+        static auto Check(int) -> decltype(std::declval<A &>().reallocate(
+                                               std::declval<typename A::value_type *>(), size_t(), size_t()),
+                                           std::true_type());
+        template <class A>
+        static std::false_type Check(...);
+
+    public:
+        static constexpr bool value = decltype(Check<Alloc>(0))::value; ///< 萃取结果
+    };
+}
+
+/// @brief 声明自定义类型可平凡重定位，需在全局命名空间中使用
+#define XUSTL_TRIVIALLY_RELOCATABLE(Type)                            \
+    namespace XuSTL                                                  \
+    {                                                                \
+        template <>                                                  \
+        struct IsTriviallyRelocatable<Type> : std::true_type         \
+        {                                                            \
+        };                                                           \
+    }
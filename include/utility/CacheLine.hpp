@@ -0,0 +1,11 @@
+/// @file CacheLine.hpp
+/// @brief 缓存行大小
+/// @details 多线程频繁写入的变量各占一个缓存行，避免伪共享。
+///          C++17 的 std::hardware_destructive_interference_size 在 C++11 中不可用，取常见的 64 字节。
+#pragma once
+#include <cstddef>
+
+namespace XuSTL
+{
+    static constexpr size_t CacheLineSize = 64; ///< 缓存行字节数
+}
@@ -0,0 +1,19 @@
+/// @file Debug.hpp
+/// @brief 调试检查开关
+/// @details 定义 XUSTL_DEBUG 后容器和迭代器会检查越界访问并抛出 std::out_of_range；
+///          未定义时检查语句被完全移除，发布版本没有任何额外开销。
+#pragma once
+#include <stdexcept>
+
+#ifdef XUSTL_DEBUG
+/// @brief 调试检查，条件不成立时抛出 std::out_of_range
+#define XUSTL_DEBUG_CHECK(cond, msg)         \
+    do                                       \
+    {                                        \
+        if (!(cond))                         \
+            throw std::out_of_range(msg);    \
+    } while (0)
+#else
+/// @brief 调试检查，发布版本为空
+#define XUSTL_DEBUG_CHECK(cond, msg) ((void)0)
+#endif
@@ -0,0 +1,350 @@
+/// @file Serialize.hpp
+/// @brief 容器二进制序列化格式与读写器
+/// @details 格式为 24 字节文件头 + 数据区，整数均为本机字节序：
+///          | magic "XUST" 4 | version 2 | kind 1 | flags 1 | elem_size 4 | reserved 4 | count 8 |
+///          flags 含 SerialBulk 时数据区是元素的原始字节，否则是逐个元素经 Serializer<T> 编码的结果。
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace XuSTL
+{
+    /// @brief 序列化格式版本
+    const uint16_t SerialVersion = 1;
+    /// @brief 数据区为原始字节
+    const uint8_t SerialBulk = 0x01;
+
+    /// @brief 容器种类
+    enum class SerialKind : uint8_t
+    {
+        Vector = 1,
+        List = 2,
+        HashTable = 3
+    };
+
+    /// @brief 文件头
+    struct SerialHeader
+    {
+        char magic[4];      ///< 固定为 "XUST"
+        uint16_t version;   ///< 格式版本
+        uint8_t kind;       ///< 容器种类
+        uint8_t flags;      ///< 标志位
+        uint32_t elem_size; ///< sizeof(T)，用于校验
+        uint32_t reserved;  ///< 保留
+        uint64_t count;     ///< 元素个数
+    };
+    static_assert(sizeof(SerialHeader) == 24, "文件头必须是 24 字节");
+
+    /// @brief 基于 std::ostream 的写入器
+    class StreamWriter
+    {
+    public:
+        explicit StreamWriter(std::ostream &os) : _os(os) {}
+        /// @brief 写入 n 字节
+        /// @throws std::runtime_error 写入失败时抛出
+        void write(const void *p, size_t n)
+        {
+            _os.write(static_cast<const char *>(p), n);
+            if (!_os)
+                throw std::runtime_error("序列化写入失败！");
+        }
+        /// @brief 写入大块数据
+        void write_bulk(const void *p, size_t n) { write(p, n); }
+        /// @brief 按顺序写入多段数据
+        void write_gather(const struct iovec *iov, size_t cnt)
+        {
+            for (size_t i = 0; i < cnt; i++)
+                write(iov[i].iov_base, iov[i].iov_len);
+        }
+        /// @brief 刷新缓冲区
+        void flush() { _os.flush(); }
+
+    private:
+        std::ostream &_os; ///< 输出流
+    };
+
+    /// @brief 基于文件描述符的写入器，小块数据先进缓冲区，大块数据与缓冲区一起用 writev 写出
+    class FdWriter
+    {
+    public:
+        explicit FdWriter(int fd) : _fd(fd), _len(0) {}
+        FdWriter(const FdWriter &) = delete;
+        FdWriter &operator=(const FdWriter &) = delete;
+        /// @brief 写入 n 字节
+        /// @throws std::system_error 写入失败时抛出
+        void write(const void *p, size_t n)
+        {
+            if (_len + n > sizeof(_buf))
+            {
+                write_bulk(p, n);
+                return;
+            }
+            std::memcpy(_buf + _len, p, n);
+            _len += n;
+        }
+        /// @brief 把缓冲区和这块数据用一次 writev 写出，数据不经过缓冲区拷贝
+        /// @throws std::system_error 写入失败时抛出
+        void write_bulk(const void *p, size_t n)
+        {
+            struct iovec iov[2];
+            iov[0].iov_base = _buf;
+            iov[0].iov_len = _len;
+            iov[1].iov_base = const_cast<void *>(p);
+            iov[1].iov_len = n;
+            _len = 0;
+            WritevAll(iov, 2);
+        }
+        /// @brief 把缓冲区和多段数据用 writev 写出
+        /// @throws std::system_error 写入失败时抛出
+        void write_gather(const struct iovec *iov, size_t cnt)
+        {
+            flush();
+            struct iovec batch[IOV_MAX];
+            while (cnt != 0)
+            {
+                size_t k = cnt < IOV_MAX ? cnt : IOV_MAX;
+                std::memcpy(batch, iov, k * sizeof(struct iovec));
+                WritevAll(batch, k);
+                iov += k;
+                cnt -= k;
+            }
+        }
+        /// @brief 写出缓冲区
+        /// @throws std::system_error 写入失败时抛出
+        void flush()
+        {
+            if (_len == 0)
+                return;
+            struct iovec iov;
+            iov.iov_base = _buf;
+            iov.iov_len = _len;
+            _len = 0;
+            WritevAll(&iov, 1);
+        }
+
+    private:
+        /// @brief 循环 writev 直到全部写完，会修改 iov
+        void WritevAll(struct iovec *iov, size_t cnt)
+        {
+            while (cnt != 0)
+            {
+                ssize_t w = ::writev(_fd, iov, static_cast<int>(cnt));
+                if (w < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category(), "序列化写入失败");
+                }
+                size_t done = static_cast<size_t>(w);
+                while (cnt != 0 && done >= iov->iov_len)
+                {
+                    done -= iov->iov_len;
+                    ++iov, --cnt;
+                }
+                if (cnt != 0)
+                {
+                    iov->iov_base = static_cast<char *>(iov->iov_base) + done;
+                    iov->iov_len -= done;
+                }
+            }
+        }
+
+    private:
+        int _fd;                ///< 文件描述符
+        size_t _len;            ///< 缓冲区已用字节数
+        char _buf[64 * 1024];   ///< 小块数据缓冲区
+    };
+
+    /// @brief 基于 std::istream 的读取器
+    class StreamReader
+    {
+    public:
+        explicit StreamReader(std::istream &is) : _is(is) {}
+        /// @brief 读取 n 字节
+        /// @throws std::runtime_error 数据不足时抛出
+        void read(void *p, size_t n)
+        {
+            _is.read(static_cast<char *>(p), n);
+            if (static_cast<size_t>(_is.gcount()) != n)
+                throw std::runtime_error("序列化数据不完整！");
+        }
+
+    private:
+        std::istream &_is; ///< 输入流
+    };
+
+    /// @brief 基于文件描述符的读取器，大块读取直接读入目标内存
+    /// @details 可定位的描述符（普通文件）上小块读取经过预读缓冲区，析构时把预读但未使用的字节退回，
+    ///          使后续读取接着容器数据末尾进行。管道、套接字等无法退回，只按请求的字节数精确读取，
+    ///          不会读走容器数据之后的内容，同一条流上可以连续反序列化多个容器。
+    class FdReader
+    {
+    public:
+        explicit FdReader(int fd) : _fd(fd), _pos(0), _len(0), _seekable(::lseek(fd, 0, SEEK_CUR) != -1) {}
+        FdReader(const FdReader &) = delete;
+        FdReader &operator=(const FdReader &) = delete;
+        ~FdReader()
+        {
+            if (_len > _pos)
+                ::lseek(_fd, -static_cast<off_t>(_len - _pos), SEEK_CUR);
+        }
+        /// @brief 读取 n 字节
+        /// @throws std::runtime_error 数据不足时抛出
+        /// @throws std::system_error 读取失败时抛出
+        void read(void *p, size_t n)
+        {
+            char *dst = static_cast<char *>(p);
+            size_t k = _len - _pos < n ? _len - _pos : n;
+            std::memcpy(dst, _buf + _pos, k);
+            _pos += k, dst += k, n -= k;
+            if (n == 0)
+                return;
+            if (n >= sizeof(_buf) || !_seekable)
+            {
+                ReadAll(dst, n, n); // 大块直接读入目标内存，不可定位时不预读
+                return;
+            }
+            _pos = 0;
+            _len = ReadAll(_buf, sizeof(_buf), n);
+            std::memcpy(dst, _buf, n);
+            _pos = n;
+        }
+
+    private:
+        /// @brief 至少读取 need 字节，最多 cap 字节
+        /// @return 实际读取的字节数
+        size_t ReadAll(char *dst, size_t cap, size_t need)
+        {
+            size_t got = 0;
+            while (got < need)
+            {
+                ssize_t r = ::read(_fd, dst + got, cap - got);
+                if (r < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::system_error(errno, std::generic_category(), "序列化读取失败");
+                }
+                if (r == 0)
+                    throw std::runtime_error("序列化数据不完整！");
+                got += static_cast<size_t>(r);
+            }
+            return got;
+        }
+
+    private:
+        int _fd;              ///< 文件描述符
+        size_t _pos;          ///< 缓冲区读取位置
+        size_t _len;          ///< 缓冲区有效字节数
+        bool _seekable;       ///< 能否退回预读的字节
+        char _buf[64 * 1024]; ///< 预读缓冲区
+    };
+
+    /// @brief 单个元素的编码方式，平凡可拷贝类型直接写原始字节，其他类型需要特化
+    /// @tparam T 数据类型
+    template <class T, class = void>
+    struct Serializer
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "该类型需要特化 XuSTL::Serializer");
+        template <class Writer>
+        static void write(Writer &w, const T &value) { w.write(&value, sizeof(T)); }
+        template <class Reader>
+        static void read(Reader &r, T &value) { r.read(&value, sizeof(T)); }
+    };
+    /// @brief 字符串：8 字节长度 + 字符
+    template <class Char, class Traits, class A>
+    struct Serializer<std::basic_string<Char, Traits, A>>
+    {
+        template <class Writer>
+        static void write(Writer &w, const std::basic_string<Char, Traits, A> &value)
+        {
+            uint64_t n = value.size();
+            w.write(&n, sizeof(n));
+            w.write(value.data(), n * sizeof(Char));
+        }
+        /// @details 长度来自外部数据，不能据此一次分配：每次最多扩展 64KB 并读入新的尾部，
+        ///          数据被截断时在分配大块内存之前就抛出异常
+        template <class Reader>
+        static void read(Reader &r, std::basic_string<Char, Traits, A> &value)
+        {
+            uint64_t n;
+            r.read(&n, sizeof(n));
+            const uint64_t chunk = (64 * 1024) / sizeof(Char);
+            value.clear();
+            while (value.size() < n)
+            {
+                size_t done = value.size();
+                size_t k = static_cast<size_t>(n - done < chunk ? n - done : chunk);
+                value.resize(done + k);
+                r.read(&value[done], k * sizeof(Char));
+            }
+        }
+    };
+    /// @brief pair：依次编码 first 和 second
+    template <class A, class B>
+    struct Serializer<std::pair<A, B>, typename std::enable_if<!std::is_trivially_copyable<std::pair<A, B>>::value>::type>
+    {
+        template <class Writer>
+        static void write(Writer &w, const std::pair<A, B> &value)
+        {
+            Serializer<A>::write(w, value.first);
+            Serializer<B>::write(w, value.second);
+        }
+        template <class Reader>
+        static void read(Reader &r, std::pair<A, B> &value)
+        {
+            Serializer<typename std::remove_const<A>::type>::read(r, const_cast<typename std::remove_const<A>::type &>(value.first));
+            Serializer<B>::read(r, value.second);
+        }
+    };
+
+    /// @brief 写文件头
+    /// @param w 写入器
+    /// @param kind 容器种类
+    /// @param bulk 数据区是否为原始字节
+    /// @param elem_size 元素大小
+    /// @param count 元素个数
+    template <class Writer>
+    void WriteSerialHeader(Writer &w, SerialKind kind, bool bulk, size_t elem_size, size_t count)
+    {
+        SerialHeader h;
+        std::memcpy(h.magic, "XUST", 4);
+        h.version = SerialVersion;
+        h.kind = static_cast<uint8_t>(kind);
+        h.flags = bulk ? SerialBulk : 0;
+        h.elem_size = static_cast<uint32_t>(elem_size);
+        h.reserved = 0;
+        h.count = count;
+        w.write(&h, sizeof(h));
+    }
+    /// @brief 读取并校验文件头
+    /// @param r 读取器
+    /// @param kind 期望的容器种类
+    /// @param elem_size 期望的元素大小
+    /// @param bulk 期望的数据区格式
+    /// @return 文件头
+    /// @throws std::runtime_error 格式不匹配时抛出
+    template <class Reader>
+    SerialHeader ReadSerialHeader(Reader &r, SerialKind kind, size_t elem_size, bool bulk)
+    {
+        SerialHeader h;
+        r.read(&h, sizeof(h));
+        if (std::memcmp(h.magic, "XUST", 4) != 0 || h.version != SerialVersion)
+            throw std::runtime_error("不是 XuSTL 序列化数据或版本不支持！");
+        if (h.kind != static_cast<uint8_t>(kind) || h.elem_size != elem_size ||
+            ((h.flags & SerialBulk) != 0) != bulk)
+            throw std::runtime_error("序列化数据与容器类型不匹配！");
+        return h;
+    }
+}
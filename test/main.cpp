@@ -1,14 +1,80 @@
 #include "Vector.hpp"
+#include "SmallVector.hpp"
+#include "MmapVector.hpp"
 #include "List.hpp"
+#include "ChunkedList.hpp"
+#include "IntrusiveList.hpp"
+#include "IndexedList.hpp"
+#include "RingBuffer.hpp"
+#include "SPSCQueue.hpp"
+#include "MPMCQueue.hpp"
+#include "Channel.hpp"
+#include "AsyncQueue.hpp"
+#include "ConcurrentStack.hpp"
+#include "Deque.hpp"
 #include "Stack.hpp"
 #include "Queue.hpp"
 #include "HashTable.hpp"
+#include "../memory/MallocAllocator.hpp"
+#include "../memory/MonotonicArena.hpp"
+#include "../algorithm/Simd.hpp"
+#include "../algorithm/Parallel.hpp"
+#include "../algorithm/ThreadPool.hpp"
+#include <chrono>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <thread>
 using namespace XuSTL;
+/// @brief 统计构造与存活次数的测试类型
+struct Counted
+{
+    static int constructed;
+    static int alive;
+    Counted() { ++constructed, ++alive; }
+    Counted(const Counted &) { ++constructed, ++alive; }
+    Counted &operator=(const Counted &) = default;
+    ~Counted() { --alive; }
+};
+int Counted::constructed = 0;
+int Counted::alive = 0;
+
+/// @brief 主动声明可平凡重定位的测试类型
+struct Handle
+{
+    int *_p;
+    Handle(int v = 0) : _p(new int(v)) {}
+    Handle(const Handle &other) : _p(new int(*other._p)) {}
+    Handle &operator=(const Handle &other)
+    {
+        *_p = *other._p;
+        return *this;
+    }
+    ~Handle() { delete _p; }
+};
+XUSTL_TRIVIALLY_RELOCATABLE(Handle)
+
+struct KeyOfVal
+{
+    int operator()(const std::pair<int, std::string> &pair) const
+    {
+        return pair.first; // 假设第一个元素为键
+    }
+};
+
+struct Hash
+{
+    size_t operator()(int key) const
+    {
+        return std::hash<int>()(key); // 使用标准库的哈希函数
+    }
+};
+
 void testVector()
 {
     // 测试默认构造函数
     XuSTL::Vector<int> vec1;
-    std::cout << "默认构造的 Vector，初始大小: " << vec1.size() << ", 容量: " << vec1.capacity() << std::endl;
+    std::cout << "默认构造的 Vector，初始大小: " << vec1.size() << ", 容量: " << vec1.capacity() << std::endl; // 容量应该输出 0
 
     // 测试带值构造函数
     XuSTL::Vector<int> vec2(5, 10);
@@ -57,6 +123,371 @@ void testVector()
     // 测试清空
     vec3.clear();
     std::cout << "清空后，Vector 中的元素: " << vec3.size() << std::endl;
+
+    // 测试 reserve 不构造元素
+    Counted::constructed = 0;
+    XuSTL::Vector<Counted> vec4;
+    vec4.reserve(1000);
+    std::cout << "reserve(1000) 后构造次数: " << Counted::constructed << std::endl; // 应该输出 0
+    vec4.push_back(Counted());
+    std::cout << "push_back 后存活元素: " << Counted::alive << std::endl; // 应该输出 1
+    vec4.clear();
+    std::cout << "clear 后存活元素: " << Counted::alive << std::endl; // 应该输出 0
+
+    // 测试移动赋值与原地构造
+    XuSTL::Vector<std::pair<int, std::string>> vec6;
+    vec6.emplace_back(1, "one");
+    vec6.emplace(vec6.begin(), 0, "zero");
+    vec6.push_back(std::make_pair(2, std::string("two")));
+    XuSTL::Vector<std::pair<int, std::string>> vec7;
+    vec7 = std::move(vec6);
+    std::cout << "移动赋值后，源大小: " << vec6.size() << ", 目标元素: "; // 源大小应该输出 0
+    for (const auto &value : vec7)
+        std::cout << value.first << ":" << value.second << " ";
+    std::cout << std::endl;
+
+    // 测试可平凡重定位元素的 memcpy / realloc 扩容
+    XuSTL::Vector<int, XuSTL::MallocAllocator<int>> vec8;
+    for (int i = 0; i < 100000; i++)
+        vec8.push_back(i);
+    std::cout << "realloc 扩容后，大小: " << vec8.size() << ", 末尾元素: " << vec8[vec8.size() - 1] << std::endl;
+    XuSTL::Vector<Handle> vec9;
+    for (int i = 0; i < 100; i++)
+        vec9.emplace_back(i);
+    std::cout << "memcpy 扩容后，第 50 个元素: " << *vec9[50]._p << std::endl; // 应该输出 50
+
+    // 测试范围插入与范围删除
+    XuSTL::Vector<std::string> vec10 = {"a", "e"};
+    std::string mid[] = {"b", "c", "d"};
+    vec10.insert(vec10.begin() + 1, mid, mid + 3);
+    vec10.insert(vec10.end(), 2, "f");
+    vec10.append(vec10.begin(), vec10.begin() + 2);
+    vec10.erase(vec10.begin() + 1, vec10.begin() + 4);
+    for (const auto &value : vec10)
+        std::cout << value << " "; // 应该输出 a e f f a b
+    std::cout << std::endl;
+
+    // 不扩容时经反向迭代器插入自身的元素，源范围会被腾挪的尾部覆盖
+    XuSTL::Vector<std::string> vec13 = {"a", "b", "c", "d"};
+    vec13.reserve(16);
+    vec13.insert(vec13.begin(), std::reverse_iterator<std::string *>(vec13.end()), std::reverse_iterator<std::string *>(vec13.begin()));
+    vec13.insert(vec13.end(), std::reverse_iterator<std::string *>(vec13.end()), std::reverse_iterator<std::string *>(vec13.begin()));
+    for (const auto &value : vec13)
+        std::cout << value << " "; // 应该输出 d c b a a b c d d c b a a b c d
+    std::cout << std::endl;
+
+    // 测试扩容策略与 shrink_to_fit
+    XuSTL::Vector<int, std::allocator<int>, XuSTL::PowerOfTwoGrowth> vec11;
+    for (int i = 0; i < 100; i++)
+        vec11.push_back(i);
+    std::cout << "2 的幂扩容，容量: " << vec11.capacity() << std::endl; // 应该输出 128
+    XuSTL::Vector<int, std::allocator<int>, XuSTL::PageGrowth<>> vec12;
+    vec12.push_back(1);
+    std::cout << "按页扩容，容量: " << vec12.capacity() << std::endl; // 应该输出 1024
+    vec11.shrink_to_fit();
+    std::cout << "shrink_to_fit 后容量: " << vec11.capacity() << std::endl; // 应该输出 100
+
+    // 测试越界检查：at 总是检查，[] 只在定义 XUSTL_DEBUG 时检查
+    try
+    {
+        vec11.at(100);
+    }
+    catch (const std::out_of_range &e)
+    {
+        std::cout << "at 越界: " << e.what() << std::endl;
+    }
+#ifdef XUSTL_DEBUG
+    try
+    {
+        vec11[100];
+    }
+    catch (const std::out_of_range &e)
+    {
+        std::cout << "[] 调试越界: " << e.what() << std::endl;
+    }
+#endif
+    std::cout << "front: " << vec11.front() << ", back: " << vec11.back() << ", data[1]: " << vec11.data()[1] << std::endl;
+
+    // 测试 string 元素
+    XuSTL::Vector<std::string> vec5(3, "xu");
+    vec5.insert(vec5.begin(), vec5[2]);
+    vec5.erase(vec5.begin() + 1);
+    for (const auto &value : vec5)
+        std::cout << value << " ";
+    std::cout << std::endl;
+}
+
+void testSmallVector()
+{
+    XuSTL::SmallVector<std::string, 4> sv;
+    sv.push_back("a");
+    sv.push_back("b");
+    sv.emplace_back(2, 'c');
+    std::cout << "SmallVector 大小: " << sv.size() << ", 是否内联: " << (sv.is_small() ? "是" : "否") << std::endl; // 应该输出 是
+    sv.insert(sv.begin(), "z");
+    sv.push_back("d");
+    std::cout << "超过内联容量后是否内联: " << (sv.is_small() ? "是" : "否") << ", 容量: " << sv.capacity() << std::endl; // 应该输出 否
+    for (auto rit = sv.rbegin(); rit != sv.rend(); rit++)
+        std::cout << *rit << " ";
+    std::cout << std::endl;
+
+    // 测试移动
+    XuSTL::SmallVector<std::string, 4> sv2(std::move(sv));
+    XuSTL::SmallVector<std::string, 4> sv3 = {"x", "y"};
+    sv3.swap(sv2);
+    std::cout << "swap 后大小: " << sv2.size() << " " << sv3.size() << ", 源大小: " << sv.size() << std::endl; // 应该输出 2 5, 0
+    sv3.erase(sv3.begin());
+    for (const auto &value : sv3)
+        std::cout << value << " ";
+    std::cout << std::endl;
+
+    // 有状态的分配器随堆内存一起移动
+    using ArenaSmall = XuSTL::SmallVector<int, 2, XuSTL::ArenaAllocator<int>>;
+    XuSTL::MonotonicArena arena_a, arena_b;
+    ArenaSmall a{XuSTL::ArenaAllocator<int>(&arena_a)};
+    for (int i = 0; i < 5; i++)
+        a.push_back(i);
+    ArenaSmall b(std::move(a));
+    ArenaSmall c{XuSTL::ArenaAllocator<int>(&arena_b)};
+    c = std::move(b);
+    size_t before = arena_b.allocated();
+    for (int i = 0; i < 20; i++)
+        c.push_back(i);
+    std::cout << "移动后分配器: " << (c.get_allocator().arena() == &arena_a) << ", 扩容未用 b 的 arena: " << (arena_b.allocated() == before)
+              << ", 移动不抛异常: " << std::is_nothrow_move_constructible<XuSTL::SmallVector<std::string, 4>>::value << std::endl; // 1 1 1
+}
+
+void testSimd()
+{
+    XuSTL::Vector<uint32_t> col;
+    for (uint32_t i = 0; i < 1000; i++)
+        col.push_back(i % 300);
+    XuSTL::Vector<double> dv;
+    for (int i = 0; i < 77; i++)
+        dv.push_back(i * 0.5 - 10);
+    XuSTL::Vector<int8_t> bytes(1000, 1);
+    const simd::SimdLevel levels[] = {simd::SimdLevel::Scalar, simd::SimdLevel::SSE2,
+                                      simd::SimdLevel::AVX2, simd::SimdLevel::AVX512};
+    for (auto lv : levels)
+    {
+        // 各指令集等级的结果应该一致
+        simd::force_level(lv);
+        std::cout << "SIMD 等级 " << static_cast<int>(simd::level())
+                  << ": find(299)=" << (XuSTL::find(col, 299u) - col.begin())      // 299
+                  << " count(7)=" << XuSTL::count(col, 7u)                         // 4
+                  << " contains(300)=" << XuSTL::contains(col, 300u)              // 0
+                  << " min=" << XuSTL::min(col) << " max=" << XuSTL::max(col)      // 0 299
+                  << " sum=" << XuSTL::sum(col)                                    // 139500
+                  << " dmin=" << XuSTL::min(dv) << " dmax=" << XuSTL::max(dv)      // -10 28
+                  << " dsum=" << XuSTL::sum(dv)                                    // 693
+                  << " bytes=" << XuSTL::count(bytes, int8_t(1))                   // 1000
+                  << " equal=" << XuSTL::equal(col, XuSTL::Vector<uint32_t>(col)) // 1
+                  << std::endl;
+    }
+    simd::force_level(simd::DetectLevel());
+}
+
+void testParallel()
+{
+    // 指定 4 个线程、每块 1000 个元素，保证在单核机器上也走多线程路径
+    XuSTL::execution::ParallelPolicy par4(4, 1000);
+    XuSTL::Vector<long long> v;
+    for (long long i = 0; i < 100000; i++)
+        v.push_back((i * 7919) % 100003);
+
+    XuSTL::Vector<long long> sq;
+    XuSTL::transform(par4, v, sq, [](long long x)
+                     { return x * 2; });
+    XuSTL::for_each(par4, sq, [](long long &x)
+                    { x /= 2; });
+    std::cout << "transform + for_each 后是否不变: " << (sq == v ? "是" : "否") << std::endl; // 应该输出 是
+
+    long long s1 = XuSTL::reduce(XuSTL::execution::seq, v, 0LL);
+    long long s2 = XuSTL::reduce(par4, v, 0LL);
+    std::cout << "串行 reduce: " << s1 << ", 并行 reduce: " << s2 << std::endl;
+
+    XuSTL::Vector<long long> scan1, scan2;
+    XuSTL::inclusive_scan(XuSTL::execution::seq, v, scan1);
+    XuSTL::inclusive_scan(par4, v, scan2);
+    std::cout << "并行 inclusive_scan 是否一致: " << (scan1 == scan2 ? "是" : "否")
+              << ", 末尾: " << scan2.back() << std::endl; // 末尾应等于 reduce 结果
+
+    XuSTL::Vector<long long> sorted(v);
+    XuSTL::sort(par4, sorted);
+    bool ok = true;
+    for (size_t i = 1; i < sorted.size(); i++)
+        ok = ok && sorted[i - 1] <= sorted[i];
+    std::cout << "并行 sort 是否有序: " << (ok ? "是" : "否")
+              << ", 总和不变: " << (XuSTL::reduce(XuSTL::execution::par, sorted, 0LL) == s1 ? "是" : "否") << std::endl;
+
+    // 不可平凡拷贝的元素，归并时移动不能丢数据
+    XuSTL::Vector<std::string> words, expect;
+    for (int i = 0; i < 20000; i++)
+        words.push_back(std::to_string((i * 7919) % 20011));
+    expect = words;
+    std::sort(expect.begin(), expect.end());
+    XuSTL::sort(par4, words);
+    std::cout << "并行 sort string 是否与串行一致: " << (words == expect ? "是" : "否") << std::endl; // 应该输出 是
+}
+
+// 用 spawn/sync 递归计算斐波那契数，子任务可能被其他线程窃取
+long long ParallelFib(XuSTL::ThreadPool &pool, int n)
+{
+    if (n < 16)
+        return n < 2 ? n : ParallelFib(pool, n - 1) + ParallelFib(pool, n - 2);
+    long long a = 0;
+    XuSTL::TaskGroup g;
+    pool.spawn(g, [&]()
+               { a = ParallelFib(pool, n - 1); });
+    long long b = ParallelFib(pool, n - 2);
+    pool.sync(g);
+    return a + b;
+}
+
+void testThreadPool()
+{
+    XuSTL::ThreadPool pool(4); // 指定线程数，保证在单核机器上也有窃取
+    std::cout << "ThreadPool fib(27) = " << ParallelFib(pool, 27) << std::endl; // 196418
+
+    // parallel_for 递归二分，在 Vector 上建一个前缀计数索引
+    XuSTL::Vector<int> v;
+    for (int i = 0; i < 100000; i++)
+        v.push_back(i % 10 == 0 ? 1 : 0);
+    XuSTL::Vector<int> counts(100, 0);
+    pool.parallel_for(0, 100, 1, [&](size_t b, size_t e)
+                      { for (size_t blk = b; blk < e; blk++)
+                            for (size_t i = blk * 1000; i < (blk + 1) * 1000; i++)
+                                counts[blk] += v[i]; });
+    long long total = 0;
+    bool even = true;
+    for (size_t i = 0; i < counts.size(); i++)
+        total += counts[i], even = even && counts[i] == 100;
+    std::cout << "ThreadPool parallel_for 总数: " << total << ", 每块 100 个: " << even << std::endl; // 10000 1
+
+    std::atomic<long long> sum(0);
+    pool.parallel_for(0, 1000000, 0, [&](size_t b, size_t e)
+                      { long long s = 0;
+                        for (size_t i = b; i < e; i++) s += i;
+                        sum += s; });
+    std::cout << "ThreadPool parallel_for 自动粒度求和: " << sum << std::endl; // 499999500000
+
+    // 任务中的异常在 sync 时重新抛出
+    try
+    {
+        pool.parallel_for(0, 1000, 10, [](size_t b, size_t)
+                          { if (b >= 500) throw std::runtime_error("ThreadPool 任务出错"); });
+        std::cout << "ThreadPool 未抛出异常" << std::endl;
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "ThreadPool 捕获异常: " << e.what() << std::endl;
+    }
+}
+
+void testMmapVector()
+{
+    const char *path = "/tmp/xustl_mmap_test.bin";
+    {
+        XuSTL::MmapVector<uint32_t> mv(path, XuSTL::MmapMode::Create);
+        for (uint32_t i = 0; i < 5000; i++)
+            mv.push_back(i * 3);
+        uint32_t extra[] = {7, 8, 9};
+        mv.append(extra, extra + 3);
+        std::cout << "MmapVector 大小: " << mv.size() << ", 容量: " << mv.capacity() << std::endl; // 大小应该输出 5003
+    } // 析构时截断文件到 size()
+
+    XuSTL::MmapVector<uint32_t> ro(path, XuSTL::MmapMode::ReadOnly);
+    const XuSTL::MmapVector<uint32_t> &view = ro; // 只读映射通过 const 引用访问
+    std::cout << "只读重新打开，大小: " << view.size() << ", [4999]: " << view[4999] << ", 末尾: " << view.back() << std::endl; // 5003 14997 9
+    std::cout << "反向前三个: ";
+    int shown = 0;
+    for (auto rit = view.crbegin(); rit != view.crend() && shown < 3; rit++, shown++)
+        std::cout << *rit << " ";
+    std::cout << std::endl;
+    try
+    {
+        ro.push_back(1);
+    }
+    catch (const std::logic_error &e)
+    {
+        std::cout << "只读写入: " << e.what() << std::endl;
+    }
+    try
+    {
+        ro[0] = 1; // 总是抛出异常，而不是写入 PROT_READ 映射触发段错误
+    }
+    catch (const std::logic_error &e)
+    {
+        std::cout << "只读可写访问: " << e.what() << std::endl;
+    }
+    ro.close();
+
+    // 长度不是元素大小整数倍的文件拒绝打开，不截断末尾的字节
+    int odd = ::open(path, O_WRONLY | O_TRUNC);
+    ssize_t odd_written = ::write(odd, "12345", 5);
+    ::close(odd);
+    try
+    {
+        XuSTL::MmapVector<uint32_t> rw(path, XuSTL::MmapMode::ReadWrite);
+    }
+    catch (const std::runtime_error &e)
+    {
+        struct stat st;
+        ::stat(path, &st);
+        std::cout << "长度不整齐: " << e.what() << " 文件长度仍为: " << st.st_size << "/" << odd_written << std::endl; // 5/5
+    }
+    std::remove(path);
+}
+
+void testNodePool()
+{
+    XuSTL::NodePool<XuSTL::ListNode<int>> pool;
+    void *a = pool.allocate();
+    void *b = pool.allocate();
+    pool.deallocate(a);
+    std::cout << "节点池复用释放的节点: " << (pool.allocate() == a) << ", 相邻节点: " << (b != a) << std::endl; // 1 1
+
+    // 链表反复插入删除，节点全部来自池
+    int alive = Counted::alive;
+    {
+        XuSTL::List<Counted> list;
+        for (int round = 0; round < 3; round++)
+        {
+            for (int i = 0; i < 1000; i++)
+                list.push_back(Counted());
+            for (auto it = list.begin(); it != list.end();)
+                it = list.erase(it);
+        }
+        for (int i = 0; i < 100; i++)
+            list.push_front(Counted());
+        list.clear();
+        list.push_back(Counted());
+    }
+    std::cout << "链表销毁后存活对象数变化: " << Counted::alive - alive << std::endl; // 0
+}
+
+void testArena()
+{
+    XuSTL::MonotonicArena arena(1024);
+    for (int request = 0; request < 3; request++)
+    {
+        XuSTL::Vector<int, XuSTL::ArenaAllocator<int>> v{XuSTL::ArenaAllocator<int>(&arena)};
+        for (int i = 0; i < 1000; i++)
+            v.push_back(i);
+        XuSTL::List<std::string, XuSTL::ArenaAllocator<std::string>> list({"a", "b", "c"}, XuSTL::ArenaAllocator<std::string>(&arena));
+        XuSTL::List<std::string, XuSTL::ArenaAllocator<std::string>> copy(list);
+        XuSTL::HashTable<int, std::pair<int, std::string>, KeyOfVal, Hash, XuSTL::ArenaAllocator<std::pair<int, std::string>>> table{XuSTL::ArenaAllocator<std::pair<int, std::string>>(&arena)};
+        table.Insert({7, "seven"});
+        XuSTL::Stack<int, XuSTL::Vector<int, XuSTL::ArenaAllocator<int>>> stack{XuSTL::ArenaAllocator<int>(&arena)};
+        stack.push(42);
+        XuSTL::Queue<int, XuSTL::List<int, XuSTL::ArenaAllocator<int>>> queue{XuSTL::ArenaAllocator<int>(&arena)};
+        queue.push(9);
+        if (request == 2)
+            std::cout << "arena 已分配字节 > 4000: " << (arena.allocated() > 4000) << ", 拷贝链表同一 arena: " << (copy.get_allocator() == list.get_allocator())
+                      << ", 栈顶: " << stack.top() << ", 队头: " << queue.front() << ", 找到 7: " << table.Find(7) << std::endl; // 1 1 42 9 1
+    } // 容器析构不逐个释放
+    arena.reset();
+    std::cout << "reset 后已分配字节: " << arena.allocated() << std::endl; // 0
 }
 
 void testList()
@@ -122,6 +553,419 @@ void testList()
     std::cout << "Size after clear: " << list.size() << std::endl; // 应该输出 0
 }
 
+void testListSplice()
+{
+    XuSTL::List<int> a = {5, 1, 4};
+    {
+        XuSTL::List<int> b = {9, 8};
+        XuSTL::List<int> c = {7, 6};
+        a.splice(a.begin(), b);                          // 9 8 5 1 4
+        a.splice(a.end(), c, c.begin());                 // 9 8 5 1 4 7
+        auto mid = ++a.begin();
+        a.splice(a.end(), a, a.begin(), ++mid);          // 5 1 4 7 9 8
+        c.push_back(3);                                  // c 与 a 共享节点池
+        a.splice(a.begin(), c, c.begin(), c.end());      // 6 3 5 1 4 7 9 8
+    } // b c 销毁后 a 的节点仍然有效
+    std::cout << "splice 后: ";
+    for (auto it = a.begin(); it != a.end(); ++it)
+        std::cout << *it << " ";
+    std::cout << "大小: " << a.size() << std::endl; // 6 3 5 1 4 7 9 8 大小: 8
+
+    a.sort();
+    XuSTL::List<int> d = {0, 2, 2, 10};
+    a.merge(d);
+    a.unique();
+    a.reverse();
+    std::cout << "sort merge unique reverse 后: ";
+    for (auto it = a.begin(); it != a.end(); ++it)
+        std::cout << *it << " ";
+    std::cout << "大小: " << a.size() << ", 尾: " << a.back() << std::endl; // 10 9 8 7 6 5 4 3 2 1 0 大小: 11, 尾: 0
+
+    // 稳定性：按十位排序，个位保持原顺序
+    XuSTL::List<int> e = {31, 12, 33, 14, 35, 16};
+    e.sort([](int x, int y)
+           { return x / 10 < y / 10; });
+    std::cout << "稳定排序: ";
+    for (auto it = e.begin(); it != e.end(); ++it)
+        std::cout << *it << " ";
+    std::cout << std::endl; // 12 14 16 31 33 35
+}
+
+void testChunkedList()
+{
+    XuSTL::ChunkedList<int, 4> cl = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto it = cl.begin();
+    for (int i = 0; i < 2; i++)
+        ++it;
+    it = cl.insert(it, 100); // 所在块已满，对半分裂
+    cl.erase(++it);          // 删除 3
+    cl.push_front(0);
+    cl.pop_back();
+    std::cout << "ChunkedList: ";
+    for (auto v : cl)
+        std::cout << v << " ";
+    std::cout << "大小: " << cl.size() << std::endl; // 0 1 2 100 4 5 6 7 8 大小: 9
+    std::cout << "反向: ";
+    for (auto rit = cl.rbegin(); rit != cl.rend(); ++rit)
+        std::cout << *rit << " ";
+    std::cout << std::endl; // 8 7 6 5 4 100 2 1 0
+    const XuSTL::ChunkedList<int, 4> copy(cl);
+    int sum = 0;
+    for (auto cit = copy.begin(); cit != copy.end(); ++cit)
+        sum += *cit;
+    std::cout << "拷贝相等: " << (copy == cl) << ", 和: " << sum << ", 首: " << copy.front() << ", 尾: " << copy.back() << std::endl; // 1 133 0 8
+}
+
+/// @brief 侵入式链表的测试元素
+struct Conn
+{
+    int id;
+    XuSTL::IntrusiveListHook hook;
+    Conn(int i) : id(i) {}
+};
+
+void testIntrusiveList()
+{
+    Conn conns[] = {Conn(1), Conn(2), Conn(3), Conn(4)};
+    XuSTL::IntrusiveList<Conn, &Conn::hook> idle, active;
+    for (auto &c : conns)
+        idle.push_back(c);
+    idle.erase(conns[2]); // 只凭引用 O(1) 移除
+    active.push_front(conns[2]);
+    idle.erase(conns[0]);
+    active.push_back(conns[0]);
+    std::cout << "idle: ";
+    for (auto &c : idle)
+        std::cout << c.id << " ";
+    std::cout << "active: ";
+    for (auto it = active.rbegin(); it != active.rend(); ++it)
+        std::cout << (*it).id << " ";
+    std::cout << std::endl; // idle: 2 4 active: 1 3
+
+    idle.splice(idle.begin(), active);
+    std::cout << "splice 后 idle 大小: " << idle.size() << ", 首: " << idle.front().id << ", active 为空: " << active.empty() << std::endl; // 4 3 1
+    idle.clear();
+    std::cout << "clear 后仍链接: " << conns[0].hook.is_linked() << std::endl; // 0
+}
+
+void testIndexedList()
+{
+    XuSTL::IndexedList<int> il{10, 20, 30, 40};
+    il.insert_at(2, 25);
+    il.erase_at(0);
+    il.push_front(5);
+    std::cout << "IndexedList: ";
+    for (size_t i = 0; i < il.size(); i++)
+        std::cout << il[i] << " ";
+    std::cout << "下标: " << il.index_of(--il.end()) << std::endl; // 5 20 25 30 40 下标: 4
+
+    // 与 Vector 对照随机插删
+    XuSTL::IndexedList<int> big;
+    XuSTL::Vector<int> ref;
+    unsigned seed = 1;
+    bool same = true;
+    for (int i = 0; i < 20000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t r = seed >> 8;
+        if (ref.size() > 0 && r % 3 == 0)
+        {
+            size_t pos = r % ref.size();
+            big.erase_at(pos);
+            ref.erase(ref.begin() + pos);
+        }
+        else
+        {
+            size_t pos = r % (ref.size() + 1);
+            big.insert_at(pos, i);
+            ref.insert(ref.begin() + pos, i);
+        }
+    }
+    for (size_t i = 0; i < ref.size(); i++)
+        same = same && big[i] == ref[i];
+    size_t i = 0;
+    for (auto it = big.begin(); it != big.end(); ++it, ++i)
+        same = same && *it == ref[i] && big.index_of(it) == i;
+    std::cout << "随机插删 " << big.size() << " 个元素后与 Vector 一致: " << same << std::endl; // 1
+}
+
+void testRingBuffer()
+{
+    XuSTL::RingBuffer<std::string> rb;
+    for (int i = 0; i < 20; i++)
+        rb.push_back(std::to_string(i));
+    for (int i = 0; i < 15; i++)
+        rb.pop_front();
+    rb.push_front("x");
+    std::cout << "RingBuffer 容量: " << rb.capacity() << ", 元素: ";
+    for (auto &s : rb)
+        std::cout << s << " ";
+    std::cout << "反向首: " << *rb.rbegin() << std::endl; // 32 x 15 16 17 18 19 19
+
+    XuSTL::RingBuffer<int> last(4, XuSTL::RingMode::Overwrite);
+    for (int i = 1; i <= 6; i++)
+        last.push_back(i);
+    std::cout << "Overwrite 容量: " << last.capacity() << ", 元素: ";
+    for (size_t i = 0; i < last.size(); i++)
+        std::cout << last[i] << " ";
+    std::cout << std::endl; // 4 3 4 5 6
+
+    // 满时插入自身的元素：先构造再扩容或覆盖
+    XuSTL::RingBuffer<std::string> grow(2), ring(2, XuSTL::RingMode::Overwrite);
+    grow.push_back("first long enough to live on the heap");
+    grow.push_back("b");
+    grow.push_back(grow.front());
+    ring.push_back("a");
+    ring.push_back("second long enough to live on the heap");
+    ring.push_front(ring.back());
+    std::cout << "满时插入自身元素: " << (grow.back() == grow.front()) << " " << (ring.front() == "second long enough to live on the heap") << std::endl; // 1 1
+
+    XuSTL::Queue<int, XuSTL::RingBuffer<int>> q;
+    long long sum = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        q.push(i);
+        if (i % 3 == 0)
+        {
+            sum += q.front();
+            q.pop();
+        }
+    }
+    while (!q.empty())
+    {
+        sum += q.front();
+        q.pop();
+    }
+    std::cout << "RingBuffer 队列出队总和: " << sum << std::endl; // 499500
+}
+
+void testSPSCQueue()
+{
+    XuSTL::SPSCQueue<int> q(1000);
+    const int n = 1000000;
+    std::thread producer([&q, n]()
+                         {
+        int batch[64];
+        for (int next = 0; next < n;)
+        {
+            int k = n - next < 64 ? n - next : 64;
+            for (int i = 0; i < k; i++)
+                batch[i] = next + i;
+            size_t pushed = q.try_push_n(batch, k);
+            next += static_cast<int>(pushed);
+            if (pushed == 0)
+                std::this_thread::yield();
+        } });
+    int buf[64];
+    int expect = 0;
+    bool ordered = true;
+    while (expect < n)
+    {
+        size_t k = q.try_pop_n(buf, 64);
+        for (size_t i = 0; i < k; i++)
+            ordered = ordered && buf[i] == expect++;
+        if (k == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    std::cout << "SPSCQueue 容量: " << q.capacity() << ", 按序收到 " << expect << " 个: " << ordered << ", 剩余: " << q.size() << std::endl; // 1024 1000000 1 0
+}
+
+void testMPMCQueue()
+{
+    XuSTL::MPMCQueue<long long> q(64);
+    long long x = 0;
+    std::cout << "MPMCQueue 空时 try_pop: " << q.try_pop(x) << ", 容量: " << q.capacity() << std::endl; // 0 64
+
+    // 压力测试：容量很小，生产者和消费者都会频繁自旋和休眠
+    const int producers = 4, consumers = 4, per = 100000;
+    std::atomic<long long> sum(0), count(0);
+    auto start = std::chrono::steady_clock::now();
+    XuSTL::Vector<std::thread> threads;
+    for (int c = 0; c < consumers; c++)
+        threads.emplace_back([&]()
+                             {
+            long long local = 0, n = 0, v;
+            for (;;)
+            {
+                q.pop(v);
+                if (v < 0)
+                    break;
+                local += v;
+                n++;
+            }
+            sum += local;
+            count += n; });
+    XuSTL::Vector<std::thread> pushers;
+    for (int p = 0; p < producers; p++)
+        pushers.emplace_back([&, p]()
+                             {
+            for (int i = 0; i < per; i++)
+                q.push(static_cast<long long>(p) * per + i); });
+    for (auto &t : pushers)
+        t.join();
+    for (int c = 0; c < consumers; c++)
+        q.push(-1); // 每个消费者一个结束标记
+    for (auto &t : threads)
+        t.join();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    long long total = static_cast<long long>(producers) * per;
+    std::cout << "MPMCQueue 收到 " << count << " 个, 总和正确: " << (sum == total * (total - 1) / 2)
+              << ", 吞吐约 " << static_cast<long long>(total / (ms / 1000 + 1e-9)) << " 个/秒" << std::endl;
+}
+
+void testChannel()
+{
+    XuSTL::Channel<int> ch(256);
+    int x = 0;
+    XuSTL::ChannelStatus st = ch.pop_for(x, std::chrono::milliseconds(10));
+    int none[1];
+    std::cout << "Channel 空时 pop_for 超时: " << (st == XuSTL::ChannelStatus::Timeout)
+              << ", pop_bulk 0 个不等待: " << ch.pop_bulk(none, 0) << std::endl; // 1 0
+
+    const int n = 100000;
+    std::thread producer([&ch, n]()
+                         {
+        int batch[100];
+        for (int i = 0; i < n; i += 100)
+        {
+            for (int j = 0; j < 100; j++)
+                batch[j] = i + j;
+            ch.push_bulk(batch, batch + 100);
+        }
+        ch.close(); });
+    long long sum = 0, count = 0;
+    int buf[64];
+    size_t k;
+    while ((k = ch.pop_bulk(buf, 64)) > 0)
+    {
+        for (size_t i = 0; i < k; i++)
+            sum += buf[i];
+        count += k;
+    }
+    producer.join();
+    std::cout << "Channel 收到 " << count << " 个, 总和正确: " << (sum == 1LL * n * (n - 1) / 2)
+              << ", 关闭后 push: " << ch.push(1) << ", pop: " << ch.pop(x) << std::endl; // 100000 1 0 0
+}
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+XuSTL::AsyncTask asyncConsumer(XuSTL::AsyncQueue<int> &q, long long &sum, int n)
+{
+    for (int i = 0; i < n; i++)
+        sum += co_await q.pop();
+}
+
+XuSTL::AsyncTask asyncProducer(XuSTL::Executor &exec, XuSTL::AsyncQueue<int> &q, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        q.push(i);
+        if (i % 100 == 0)
+            co_await exec.yield();
+    }
+}
+
+void testAsyncQueue()
+{
+    XuSTL::Executor exec;
+    XuSTL::AsyncQueue<int> q(exec);
+    long long sum = 0;
+    for (int c = 0; c < 1000; c++) // 一千个消费者协程共用一个线程
+        exec.spawn(asyncConsumer(q, sum, 10));
+    exec.run();
+    std::cout << "AsyncQueue 等待中的协程: " << q.waiters();
+    exec.spawn(asyncProducer(exec, q, 10000));
+    exec.run();
+    std::cout << ", 生产后总和: " << sum << ", 剩余等待: " << q.waiters() << std::endl; // 1000 49995000 0
+}
+#else
+void testAsyncQueue()
+{
+    std::cout << "AsyncQueue 需要 C++20 协程，跳过" << std::endl;
+}
+#endif
+
+void testConcurrentStack()
+{
+    XuSTL::ConcurrentStack<int> st;
+    st.push(1);
+    st.push(2);
+    st.push(3);
+    int all[3];
+    size_t n = st.pop_all(all);
+    std::cout << "ConcurrentStack pop_all " << n << " 个: " << all[0] << " " << all[1] << " " << all[2] << ", 之后为空: " << st.empty() << std::endl; // 3 3 2 1 1
+
+    // 多线程交替 push 和 try_pop，像共享空闲链表那样使用
+    const int threads = 4, per = 50000;
+    std::atomic<long long> popped_sum(0), popped(0);
+    XuSTL::Vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t]()
+                             {
+            long long sum = 0, cnt = 0;
+            int v;
+            for (int i = 0; i < per; i++)
+            {
+                st.push(t * per + i);
+                if (i % 2 == 0 && st.try_pop(v))
+                    sum += v, cnt++;
+            }
+            popped_sum += sum;
+            popped += cnt; });
+    for (auto &w : workers)
+        w.join();
+    long long rest_sum = 0, rest = 0;
+    int v;
+    while (st.try_pop(v))
+        rest_sum += v, rest++;
+    long long total = 1LL * threads * per;
+    std::cout << "ConcurrentStack 元素数正确: " << (popped + rest == total)
+              << ", 总和正确: " << (popped_sum + rest_sum == total * (total - 1) / 2) << std::endl; // 1 1
+}
+
+void testDeque()
+{
+    XuSTL::Deque<int, 4> dq = {3, 4, 5};
+    dq.push_front(2);
+    dq.push_front(1);
+    dq.push_back(6);
+    int *addr = &dq[2];
+    for (int i = 0; i < 20; i++) // 两端插入不移动已有元素
+        dq.push_front(-i), dq.push_back(100 + i);
+    bool stable = addr == &dq[22];
+    for (int i = 0; i < 20; i++)
+        dq.pop_front(), dq.pop_back();
+    std::cout << "Deque: ";
+    for (auto v : dq)
+        std::cout << v << " ";
+    std::cout << "反向: ";
+    for (auto it = dq.rbegin(); it != dq.rend(); ++it)
+        std::cout << *it << " ";
+    std::cout << "地址不变: " << stable << ", 末尾-开头: " << (dq.end() - dq.begin()) << std::endl; // 1 2 3 4 5 6 反向: 6 5 4 3 2 1 1 6
+
+    // 滑动窗口：一端进一端出
+    XuSTL::Deque<long long> window;
+    long long sum = 0, best = 0;
+    for (long long i = 0; i < 100000; i++)
+    {
+        window.push_back(i % 1000);
+        sum += i % 1000;
+        if (window.size() > 64)
+        {
+            sum -= window.front();
+            window.pop_front();
+        }
+        best = sum > best ? sum : best;
+    }
+    std::cout << "滑动窗口大小: " << window.size() << ", 最大窗口和: " << best << std::endl; // 64 61920
+
+    XuSTL::Stack<int, XuSTL::Deque<int>> st;
+    XuSTL::Queue<int, XuSTL::Deque<int>> q;
+    for (int i = 1; i <= 3; i++)
+        st.push(i), q.push(i);
+    std::cout << "Deque 栈顶: " << st.top() << ", 队头: " << q.front() << std::endl; // 3 1
+}
+
 void testStack()
 {
     XuSTL::Stack<int, XuSTL::List<int>> intStack;
@@ -180,29 +1024,16 @@ void testQueue()
         intQueue.pop();
         std::cout << "出队所有元素后，队列是否为空？: " << (intQueue.empty() ? "是" : "否") << std::endl;
 
-        // 测试出队空队列时的异常
+#ifdef XUSTL_DEBUG
+        // 测试出队空队列时的异常，发布版本不检查
         intQueue.pop();
+#endif
     }
     catch (const std::out_of_range &e)
     {
         std::cerr << "错误: " << e.what() << std::endl;
     }
 }
-struct KeyOfVal
-{
-    int operator()(const std::pair<int, std::string> &pair) const
-    {
-        return pair.first; // 假设第一个元素为键
-    }
-};
-
-struct Hash
-{
-    size_t operator()(int key) const
-    {
-        return std::hash<int>()(key); // 使用标准库的哈希函数
-    }
-};
 void testHash()
 {
 
@@ -223,12 +1054,134 @@ void testHash()
     }
 }
 
+void testSerialize()
+{
+    // 平凡可拷贝：经文件描述符整块写出、按块读回
+    const char *path = "/tmp/xustl_serialize_test.bin";
+    XuSTL::Vector<double> nums;
+    for (int i = 0; i < 200000; i++)
+        nums.push_back(i * 0.5);
+    XuSTL::List<int> list = {4, 5, 6};
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    nums.serialize(fd);
+    list.serialize(fd);
+    ::lseek(fd, 0, SEEK_SET);
+    XuSTL::Vector<double> nums2 = {1.0};
+    XuSTL::List<int> list2;
+    nums2.deserialize(fd);
+    list2.deserialize(fd); // 紧接着上一个容器读取
+    ::close(fd);
+    std::remove(path);
+    std::cout << "Vector 反序列化大小: " << nums2.size() << ", 相等: " << (nums2 == nums) << ", 末尾: " << nums2.back() << std::endl; // 200000 1 99999.5
+    std::cout << "List 反序列化: ";
+    for (auto it = list2.begin(); it != list2.end(); ++it)
+        std::cout << *it << " "; // 4 5 6
+    std::cout << std::endl;
+
+    // 非平凡类型：经流逐个元素编码
+    std::stringstream ss;
+    XuSTL::Vector<std::string> words = {"alpha", "", "gamma"};
+    words.serialize(ss);
+    XuSTL::HashTable<int, std::pair<int, std::string>, KeyOfVal, Hash> table;
+    table.Insert({1, "one"});
+    table.Insert({12, "twelve"});
+    table.Serialize(ss);
+    XuSTL::Vector<std::string> words2;
+    words2.deserialize(ss);
+    XuSTL::HashTable<int, std::pair<int, std::string>, KeyOfVal, Hash> table2;
+    table2.Deserialize(ss);
+    std::cout << "字符串反序列化: " << words2[0] << "," << words2[1] << "," << words2[2] << std::endl; // alpha,,gamma
+    std::cout << "HashTable 反序列化大小: " << table2.Size() << ", 找到 12: " << table2.Find(12) << std::endl; // 2 1
+
+    // 管道不可定位：读取器不能预读，连续反序列化两个容器
+    int pfd[2];
+    if (::pipe(pfd) == 0)
+    {
+        XuSTL::Vector<std::string> piped = {"x", "yy"};
+        XuSTL::Vector<int> piped_nums = {1, 2, 3};
+        piped.serialize(pfd[1]);
+        piped_nums.serialize(pfd[1]);
+        ::close(pfd[1]);
+        XuSTL::Vector<std::string> piped2;
+        XuSTL::Vector<int> piped_nums2;
+        piped2.deserialize(pfd[0]);
+        piped_nums2.deserialize(pfd[0]);
+        ::close(pfd[0]);
+        std::cout << "管道连续反序列化: " << (piped2 == piped) << " " << (piped_nums2 == piped_nums) << std::endl; // 1 1
+    }
+
+    // 文件头中的元素个数不可信：按实际数据扩容，不会按 count 一次分配
+    std::stringstream lie;
+    XuSTL::StreamWriter lie_writer(lie);
+    XuSTL::WriteSerialHeader(lie_writer, XuSTL::SerialKind::Vector, true, sizeof(int), size_t(1) << 60);
+    int one = 1;
+    lie_writer.write(&one, sizeof(one));
+    try
+    {
+        XuSTL::Vector<int> victim;
+        victim.deserialize(lie);
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "伪造的元素个数: " << e.what() << std::endl;
+    }
+
+    // 字符串长度同样不可信
+    std::stringstream lie_str;
+    XuSTL::StreamWriter lie_str_writer(lie_str);
+    XuSTL::WriteSerialHeader(lie_str_writer, XuSTL::SerialKind::Vector, false, sizeof(std::string), 1);
+    uint64_t huge = uint64_t(1) << 60;
+    lie_str_writer.write(&huge, sizeof(huge));
+    lie_str_writer.write("abc", 3);
+    try
+    {
+        XuSTL::Vector<std::string> victim;
+        victim.deserialize(lie_str);
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "伪造的字符串长度: " << e.what() << std::endl;
+    }
+
+    // 类型不匹配
+    std::stringstream bad;
+    nums.serialize(bad);
+    try
+    {
+        XuSTL::Vector<float> wrong;
+        wrong.deserialize(bad);
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << "类型不匹配: " << e.what() << std::endl;
+    }
+}
+
 int main()
 {
-    // testVector();
-    // testList();
-    // testStack();
-    // testQueue();
+    testVector();
+    testSmallVector();
+    testSimd();
+    testParallel();
+    testThreadPool();
+    testMmapVector();
+    testNodePool();
+    testArena();
+    testList();
+    testListSplice();
+    testChunkedList();
+    testIntrusiveList();
+    testIndexedList();
+    testRingBuffer();
+    testSPSCQueue();
+    testMPMCQueue();
+    testChannel();
+    testAsyncQueue();
+    testConcurrentStack();
+    testDeque();
+    testStack();
+    testQueue();
     testHash();
+    testSerialize();
     return 0;
 }
\ No newline at end of file